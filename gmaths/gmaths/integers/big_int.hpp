@@ -0,0 +1,647 @@
+#ifndef GMATHS_INTEGERS_BIG_INT_HPP_INCLUDED
+#define GMATHS_INTEGERS_BIG_INT_HPP_INCLUDED
+
+/**
+ * @file gmaths/integers/big_int.hpp
+ * @brief Provides an arbitrary precision integer type.
+ *
+ * ::basic_big_int stores a signed integer in two's complement with as few limbs
+ * as possible. Small values are stored inside the object itself, only values
+ * exceeding ::basic_big_int::inline_capacity limbs allocate memory from the
+ * allocator. All arithmetic is delegated to the limb_span operations.
+ */
+
+#include <gmaths/integers/fixed_int.hpp>
+#include <gmaths/integers/limb_span/limb_span_add.hpp>
+#include <gmaths/integers/limb_span/limb_span_base.hpp>
+#include <gmaths/integers/limb_span/limb_span_bitwise.hpp>
+#include <gmaths/integers/limb_span/limb_span_compare.hpp>
+#include <gmaths/integers/limb_span/limb_span_div.hpp>
+#include <gmaths/integers/limb_span/limb_span_mul.hpp>
+#include <gmaths/integers/limb_span/limb_span_scratch.hpp>
+#include <gmaths/integers/limb_span/limb_span_shift.hpp>
+
+#include <array>
+#include <compare>
+#include <concepts>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @def GMATHS_BIG_INT_INLINE_LIMBS
+ * @brief Number of limbs a ::gmaths::integers::basic_big_int stores without
+ * allocating memory.
+ *
+ * The default of 4 limbs holds any 128 bit product, so that arithmetic on
+ * values of up to 128 bits never allocates.
+ */
+#ifndef GMATHS_BIG_INT_INLINE_LIMBS
+#define GMATHS_BIG_INT_INLINE_LIMBS 4
+#endif
+
+namespace gmaths::integers
+{
+
+namespace _detail_big_int
+{
+
+constexpr limb_span_option signed_option = left_signed_option | right_signed_option;
+
+/*
+ * Scratch space up to this many limbs is taken from the stack, larger scratch
+ * space from the arena of the thread.
+ */
+constexpr std::size_t stack_scratch_size = 64;
+
+/*
+ * Calls f with scratch space of n limbs.
+ */
+template<typename Func>
+constexpr void with_scratch(std::size_t n, Func f)
+{
+    if (n <= stack_scratch_size) {
+        std::array<limb_type, stack_scratch_size> scratch{ };
+        f(std::span<limb_type>(scratch));
+    } else {
+        limb_span_scratch scratch(n);
+        f(scratch.span());
+    }
+}
+
+}
+
+/**
+ * @brief Signed integer of arbitrary precision.
+ *
+ * The value is kept in two's complement in the smallest number of limbs that
+ * can represent it, zero has no limbs at all. Values of up to
+ * ::inline_capacity limbs are stored inside the object, larger values are
+ * stored in memory from the allocator.
+ *
+ * The results of the operators use the allocator of their left operand as is,
+ * so that all temporaries of an expression on integers with a
+ * `std::pmr::polymorphic_allocator` come from the same memory resource, for
+ * example an ::gmaths::utility::arena_resource that is reset after the
+ * computation. The scratch space of large multiplications and divisions is
+ * taken from ::limb_span_scratch_arena().
+ *
+ * Division truncates towards zero and the remainder has the sign of the
+ * dividend. Division by zero is undefined. Bitwise operations and shifts
+ * behave as if the integer was infinitely sign extended.
+ *
+ * @tparam Allocator allocator of ::limb_type
+ */
+template<typename Allocator = std::allocator<limb_type>>
+class basic_big_int
+{
+    using alloc_traits = std::allocator_traits<Allocator>;
+    static_assert(std::is_same_v<typename alloc_traits::value_type, limb_type>, "basic_big_int requires an allocator of limb_type");
+
+public:
+    /**
+     * @brief Type of the allocator.
+     */
+    using allocator_type = Allocator;
+
+    /**
+     * @brief Number of limbs stored without allocating memory.
+     */
+    static constexpr std::size_t inline_capacity = GMATHS_BIG_INT_INLINE_LIMBS;
+    static_assert(inline_capacity >= 2, "basic_big_int requires at least two inline limbs");
+
+    /**
+     * @brief Initializes the integer with zero.
+     */
+    constexpr basic_big_int() noexcept(noexcept(Allocator())) : basic_big_int(Allocator()) { }
+
+    /**
+     * @brief Initializes the integer with zero and the given allocator.
+     */
+    constexpr explicit basic_big_int(const Allocator& a) noexcept : _allocator{ a } { }
+
+    /**
+     * @brief Initializes the integer with the value of a builtin integer.
+     *
+     * Only builtin integers wider than the inline limbs, such as `__int128`
+     * with two inline limbs, may allocate memory.
+     */
+    template<std::integral T>
+    constexpr basic_big_int(T v, const Allocator& a = Allocator()) noexcept(builtin_limbs<T> < inline_capacity)
+        : basic_big_int(compute(a, builtin_limbs<T> + 1, [v](std::span<limb_type> d) {
+              constexpr std::size_t n = builtin_limbs<T>;
+              for (std::size_t k = 0; k < n; ++k) {
+                  d[k] = static_cast<limb_type>(v >> (k * limb_bits));
+              }
+              // unsigned values get a zero limb so that they are not negative
+              d[n] = std::is_signed_v<T> ? limb_span_sign_extension(std::span<const limb_type, n>(d.data(), n)) : 0;
+          }))
+    {
+    }
+
+    /**
+     * @brief Initializes the integer with the value of a ::fixed_int.
+     */
+    template<std::size_t Bits, bool Signed>
+    constexpr basic_big_int(const fixed_int<Bits, Signed>& v, const Allocator& a = Allocator())
+        : _allocator{ a }
+    {
+        assign_extended(v.limbs(), Signed);
+    }
+
+    /**
+     * @brief Initializes the integer from limbs in two's complement, least
+     * significant first.
+     *
+     * @param limbs limbs of the value
+     * @param is_signed whether @p limbs is sign extended or zero extended
+     * @param a the allocator
+     */
+    constexpr explicit basic_big_int(std::span<const limb_type> limbs, bool is_signed = true, const Allocator& a = Allocator())
+        : _allocator{ a }
+    {
+        assign_extended(limbs, is_signed);
+    }
+
+    constexpr basic_big_int(const basic_big_int& o)
+        : basic_big_int(o, alloc_traits::select_on_container_copy_construction(o._allocator))
+    {
+    }
+
+    constexpr basic_big_int(const basic_big_int& o, const Allocator& a)
+        : _allocator{ a }
+    {
+        assign(o.limbs());
+    }
+
+    constexpr basic_big_int(basic_big_int&& o) noexcept
+        : _allocator{ std::move(o._allocator) }
+    {
+        steal(o);
+    }
+
+    constexpr basic_big_int(basic_big_int&& o, const Allocator& a)
+        : _allocator{ a }
+    {
+        if (_allocator == o._allocator) {
+            steal(o);
+        } else {
+            assign(o.limbs());
+        }
+    }
+
+    constexpr basic_big_int& operator=(const basic_big_int& o)
+    {
+        if (this != &o) {
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                if (_allocator != o._allocator) {
+                    release();
+                    _size = 0;
+                }
+                _allocator = o._allocator;
+            }
+            assign(o.limbs());
+        }
+        return *this;
+    }
+
+    constexpr basic_big_int& operator=(basic_big_int&& o) noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+    {
+        if (this == &o) {
+            return *this;
+        }
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+            release();
+            _allocator = std::move(o._allocator);
+            steal(o);
+        } else if (_allocator == o._allocator) {
+            release();
+            steal(o);
+        } else {
+            assign(o.limbs());
+        }
+        return *this;
+    }
+
+    constexpr ~basic_big_int()
+    {
+        release();
+    }
+
+    /**
+     * @brief Returns the allocator.
+     */
+    constexpr allocator_type get_allocator() const noexcept { return _allocator; }
+
+    /**
+     * @brief Returns the low bits of the integer as a builtin integer.
+     */
+    template<std::integral T>
+    constexpr explicit operator T() const noexcept
+    {
+        if constexpr (builtin_limbs<T> == 1) {
+            return static_cast<T>(_size == 0 ? 0 : data()[0]);
+        } else {
+            limb_type ext = limb_span_sign_extension(limbs());
+            std::make_unsigned_t<T> v = 0;
+            for (std::size_t k = 0; k < builtin_limbs<T>; ++k) {
+                v |= static_cast<std::make_unsigned_t<T>>(k < _size ? data()[k] : ext) << (k * limb_bits);
+            }
+            return static_cast<T>(v);
+        }
+    }
+
+    /**
+     * @brief Tests if the integer is non-zero.
+     */
+    constexpr explicit operator bool() const noexcept { return _size != 0; }
+
+    /**
+     * @brief Returns the limbs of the integer in two's complement, least
+     * significant first.
+     */
+    constexpr std::span<const limb_type> limbs() const noexcept { return std::span<const limb_type>(data(), _size); }
+
+    /**
+     * @brief Tests if the integer is negative.
+     */
+    constexpr bool is_negative() const noexcept { return limb_span_sign_extension(limbs()) != 0; }
+
+    /**
+     * @brief Returns the number of limbs that can be stored without allocating.
+     */
+    constexpr std::size_t capacity() const noexcept { return _capacity; }
+
+    /**
+     * @brief Ensures that at least @p n limbs can be stored without
+     * allocating.
+     */
+    constexpr void reserve(std::size_t n)
+    {
+        if (n <= _capacity) {
+            return;
+        }
+        std::size_t capacity = std::max(n, 2 * _capacity);
+        limb_type* p = alloc_traits::allocate(_allocator, capacity);
+        std::copy_n(data(), _size, p);
+        release();
+        _storage.large = p;
+        _capacity = capacity;
+    }
+
+    /**@{*/
+    /**
+     * @brief Arithmetic operators.
+     */
+    constexpr basic_big_int operator+() const { return *this; }
+    constexpr basic_big_int operator-() const
+    {
+        return compute(_allocator, _size + 1, [this](auto d) { limb_span_sub<right_signed_option>(d, std::span<const limb_type>(), limbs()); });
+    }
+
+    constexpr basic_big_int& operator++() { return *this += 1; }
+    constexpr basic_big_int& operator--() { return *this -= 1; }
+    constexpr basic_big_int operator++(int) { basic_big_int r = *this; ++*this; return r; }
+    constexpr basic_big_int operator--(int) { basic_big_int r = *this; --*this; return r; }
+
+    constexpr basic_big_int& operator+=(const basic_big_int& r) { return apply_inplace(r, [](auto d, auto r2) { limb_span_add_inplace<right_signed_option>(d, r2); }, 1); }
+    constexpr basic_big_int& operator-=(const basic_big_int& r) { return apply_inplace(r, [](auto d, auto r2) { limb_span_sub_inplace<right_signed_option>(d, r2); }, 1); }
+    constexpr basic_big_int& operator*=(const basic_big_int& r) { return *this = *this * r; }
+    constexpr basic_big_int& operator/=(const basic_big_int& r) { basic_big_int q(_allocator); divrem(&q, nullptr, *this, r); return *this = std::move(q); }
+    constexpr basic_big_int& operator%=(const basic_big_int& r) { basic_big_int m(_allocator); divrem(nullptr, &m, *this, r); return *this = std::move(m); }
+
+    friend constexpr basic_big_int operator+(const basic_big_int& l, const basic_big_int& r)
+    {
+        return apply(l, r, [](auto d, auto l2, auto r2) { limb_span_add<_detail_big_int::signed_option>(d, l2, r2); }, 1);
+    }
+
+    friend constexpr basic_big_int operator-(const basic_big_int& l, const basic_big_int& r)
+    {
+        return apply(l, r, [](auto d, auto l2, auto r2) { limb_span_sub<_detail_big_int::signed_option>(d, l2, r2); }, 1);
+    }
+
+    friend constexpr basic_big_int operator*(const basic_big_int& l, const basic_big_int& r)
+    {
+        std::size_t n = l._size + r._size;
+        return compute(l._allocator, n, [&](auto d) {
+            _detail_big_int::with_scratch(limb_span_mul_scratch_size(n, l._size, r._size), [&](auto scratch) {
+                limb_span_mul<_detail_big_int::signed_option>(d, l.limbs(), r.limbs(), scratch);
+            });
+        });
+    }
+
+    friend constexpr basic_big_int operator/(const basic_big_int& l, const basic_big_int& r)
+    {
+        basic_big_int q(l._allocator);
+        divrem(&q, nullptr, l, r);
+        return q;
+    }
+
+    friend constexpr basic_big_int operator%(const basic_big_int& l, const basic_big_int& r)
+    {
+        basic_big_int m(l._allocator);
+        divrem(nullptr, &m, l, r);
+        return m;
+    }
+    /**@}*/
+
+    /**@{*/
+    /**
+     * @brief Bitwise operators.
+     */
+    constexpr basic_big_int operator~() const
+    {
+        // zero has no limbs, so the result needs room for the inverted sign
+        return compute(_allocator, _size + 1, [this](auto d) { limb_span_bitnot<arg_signed_option>(d, limbs()); });
+    }
+
+    constexpr basic_big_int& operator&=(const basic_big_int& r) { return apply_inplace(r, [](auto d, auto r2) { limb_span_bitand_inplace<right_signed_option>(d, r2); }, 0); }
+    constexpr basic_big_int& operator|=(const basic_big_int& r) { return apply_inplace(r, [](auto d, auto r2) { limb_span_bitor_inplace<right_signed_option>(d, r2); }, 0); }
+    constexpr basic_big_int& operator^=(const basic_big_int& r) { return apply_inplace(r, [](auto d, auto r2) { limb_span_bitxor_inplace<right_signed_option>(d, r2); }, 0); }
+    constexpr basic_big_int& operator<<=(std::size_t s) { return *this = *this << s; }
+    constexpr basic_big_int& operator>>=(std::size_t s) { return *this = *this >> s; }
+
+    friend constexpr basic_big_int operator&(const basic_big_int& l, const basic_big_int& r)
+    {
+        return apply(l, r, [](auto d, auto l2, auto r2) { limb_span_bitand<_detail_big_int::signed_option>(d, l2, r2); }, 0);
+    }
+
+    friend constexpr basic_big_int operator|(const basic_big_int& l, const basic_big_int& r)
+    {
+        return apply(l, r, [](auto d, auto l2, auto r2) { limb_span_bitor<_detail_big_int::signed_option>(d, l2, r2); }, 0);
+    }
+
+    friend constexpr basic_big_int operator^(const basic_big_int& l, const basic_big_int& r)
+    {
+        return apply(l, r, [](auto d, auto l2, auto r2) { limb_span_bitxor<_detail_big_int::signed_option>(d, l2, r2); }, 0);
+    }
+
+    friend constexpr basic_big_int operator<<(const basic_big_int& l, std::size_t s)
+    {
+        if (l._size == 0) {
+            return basic_big_int(l._allocator);
+        }
+        return compute(l._allocator, l._size + s / limb_bits + 1, [&](auto d) { limb_span_shl<_detail_big_int::signed_option>(d, l.limbs(), s); });
+    }
+
+    friend constexpr basic_big_int operator>>(const basic_big_int& l, std::size_t s)
+    {
+        if (s / limb_bits >= l._size) {
+            return basic_big_int(l.is_negative() ? -1 : 0, l._allocator);
+        }
+        return compute(l._allocator, l._size - s / limb_bits, [&](auto d) { limb_span_shr<_detail_big_int::signed_option>(d, l.limbs(), s); });
+    }
+    /**@}*/
+
+    /**@{*/
+    /**
+     * @brief Compares the values of the integers.
+     */
+    friend constexpr bool operator==(const basic_big_int& l, const basic_big_int& r) noexcept
+    {
+        return std::ranges::equal(l.limbs(), r.limbs());
+    }
+
+    friend constexpr std::strong_ordering operator<=>(const basic_big_int& l, const basic_big_int& r) noexcept
+    {
+        return limb_span_compare_infinite<_detail_big_int::signed_option>(l.limbs(), r.limbs());
+    }
+    /**@}*/
+
+private:
+    constexpr bool is_inline() const noexcept { return _capacity == inline_capacity; }
+    constexpr limb_type* data() noexcept { return is_inline() ? _storage.small : _storage.large; }
+    constexpr const limb_type* data() const noexcept { return is_inline() ? _storage.small : _storage.large; }
+
+    /*
+     * Frees the allocated memory, the value must be reassigned afterwards.
+     */
+    constexpr void release() noexcept
+    {
+        if (!is_inline()) {
+            alloc_traits::deallocate(_allocator, _storage.large, _capacity);
+            _storage.small[0] = 0;
+            _capacity = inline_capacity;
+        }
+    }
+
+    /*
+     * Takes over the limbs of o, whose memory must be deallocatable by the
+     * allocator of this integer.
+     */
+    constexpr void steal(basic_big_int& o) noexcept
+    {
+        if (o.is_inline()) {
+            std::copy_n(o._storage.small, o._size, _storage.small);
+        } else {
+            _storage.large = o._storage.large;
+            _capacity = o._capacity;
+            o._storage.small[0] = 0;
+            o._capacity = inline_capacity;
+        }
+        _size = o._size;
+        o._size = 0;
+    }
+
+    /*
+     * Number of limbs a builtin integer occupies.
+     */
+    template<typename T>
+    static constexpr std::size_t builtin_limbs = (sizeof(T) + sizeof(limb_type) - 1) / sizeof(limb_type);
+
+    /*
+     * Removes the limbs that merely repeat the sign of the limb below.
+     */
+    constexpr void normalize() noexcept
+    {
+        _size = normalized_size(std::span<const limb_type>(data(), _size));
+    }
+
+    static constexpr std::size_t normalized_size(std::span<const limb_type> l) noexcept
+    {
+        std::size_t n = l.size();
+        while (n > 0) {
+            limb_type below = n > 1 ? limb_span_sign_extension(l.subspan(n - 2, 1)) : 0;
+            if (l[n - 1] != below) {
+                break;
+            }
+            --n;
+        }
+        return n;
+    }
+
+    /*
+     * Assigns normalized limbs.
+     */
+    constexpr void assign(std::span<const limb_type> limbs)
+    {
+        _size = 0;
+        reserve(limbs.size());
+        std::copy(limbs.begin(), limbs.end(), data());
+        _size = limbs.size();
+    }
+
+    constexpr void assign_extended(std::span<const limb_type> limbs, bool is_signed)
+    {
+        std::size_t n = limbs.size() + 1;
+        reserve(n);
+        std::copy(limbs.begin(), limbs.end(), data());
+        data()[n - 1] = is_signed ? limb_span_sign_extension(limbs) : 0;
+        _size = n;
+        normalize();
+    }
+
+    /*
+     * Computes `f(d)` into a new integer of n limbs before normalization.
+     * Results that do not fit inline before normalization but are small enough
+     * to do so afterwards, such as the product of two 128 bit values, are
+     * computed on the stack first, so that they do not allocate.
+     */
+    template<typename Func>
+    static constexpr basic_big_int compute(const Allocator& a, std::size_t n, Func f)
+    {
+        basic_big_int d(a);
+        if (n > inline_capacity && n <= 2 * inline_capacity) {
+            std::array<limb_type, 2 * inline_capacity> buffer{ };
+            std::span<limb_type> b(buffer.data(), n);
+            f(b);
+            n = normalized_size(b);
+            d.reserve(n);
+            std::copy_n(buffer.begin(), n, d.data());
+        } else {
+            d.reserve(n);
+            f(std::span<limb_type>(d.data(), n));
+        }
+        d._size = n;
+        d.normalize();
+        return d;
+    }
+
+    /*
+     * Computes `f(d, l, r)` into a new integer of `max(l.size(), r.size()) +
+     * extra` limbs.
+     */
+    template<typename Func>
+    static constexpr basic_big_int apply(const basic_big_int& l, const basic_big_int& r, Func f, std::size_t extra)
+    {
+        return compute(l._allocator, std::max(l._size, r._size) + extra, [&](auto d) { f(d, l.limbs(), r.limbs()); });
+    }
+
+    /*
+     * Computes `f(d, r)` with d being this integer sign extended to
+     * `max(size(), r.size()) + extra` limbs.
+     */
+    template<typename Func>
+    constexpr basic_big_int& apply_inplace(const basic_big_int& r, Func f, std::size_t extra)
+    {
+        std::size_t n = std::max(_size, r._size) + extra;
+        if (n > _capacity) {
+            return *this = compute(_allocator, n, [&](auto d) {
+                std::copy_n(data(), _size, d.begin());
+                std::fill(d.begin() + _size, d.end(), limb_span_sign_extension(limbs()));
+                f(d, r.limbs());
+            });
+        }
+        limb_type* p = data();
+        std::fill(p + _size, p + n, limb_span_sign_extension(limbs()));
+        f(std::span<limb_type>(p, n), r.limbs());
+        _size = n;
+        normalize();
+        return *this;
+    }
+
+    /*
+     * Stores the absolute value of v in d as an unsigned integer of v.size()
+     * limbs.
+     */
+    static constexpr void magnitude(basic_big_int& d, const basic_big_int& v)
+    {
+        d.reserve(v._size);
+        std::span<limb_type> dp(d.data(), v._size);
+        if (v.is_negative()) {
+            limb_span_sub(dp, std::span<const limb_type>(), v.limbs());
+        } else {
+            std::copy_n(v.data(), v._size, dp.begin());
+        }
+        d._size = v._size;
+    }
+
+    /*
+     * Reinterprets the unsigned limbs of v as a signed integer and applies the
+     * sign.
+     */
+    constexpr void finish_magnitude(std::size_t n, bool negative)
+    {
+        _size = n;
+        reserve(n + 1);
+        data()[n] = 0;
+        _size = n + 1;
+        normalize();
+        if (negative) {
+            *this = -*this;
+        }
+    }
+
+    static constexpr void divrem(basic_big_int* q, basic_big_int* m, const basic_big_int& l, const basic_big_int& r)
+    {
+        assert(r._size != 0);
+
+        basic_big_int la(l._allocator);
+        basic_big_int ra(l._allocator);
+        magnitude(la, l);
+        magnitude(ra, r);
+
+        std::size_t qn = la._size >= ra._size ? la._size - ra._size + 1 : 1;
+        basic_big_int qt(l._allocator);
+        basic_big_int mt(l._allocator);
+        qt.reserve(qn);
+        mt.reserve(ra._size);
+        std::span<limb_type> qp(qt.data(), qn);
+        std::span<limb_type> mp(mt.data(), ra._size);
+
+        _detail_big_int::with_scratch(limb_span_divrem_scratch_size(la._size, ra._size), [&](auto scratch) {
+            limb_span_divrem(qp, mp, la.limbs(), ra.limbs(), scratch);
+        });
+
+        if (q) {
+            qt.finish_magnitude(qn, l.is_negative() != r.is_negative());
+            *q = std::move(qt);
+        }
+        if (m) {
+            mt.finish_magnitude(ra._size, l.is_negative());
+            *m = std::move(mt);
+        }
+    }
+
+    union storage
+    {
+        limb_type small[inline_capacity];
+        limb_type* large;
+    };
+
+    storage _storage{ };
+    std::size_t _size = 0;
+    std::size_t _capacity = inline_capacity;
+    [[no_unique_address]] Allocator _allocator;
+};
+
+/**
+ * @brief Arbitrary precision integer allocating from `std::allocator`.
+ */
+using big_int = basic_big_int<>;
+
+namespace pmr
+{
+
+/**
+ * @brief Arbitrary precision integer allocating from a
+ * `std::pmr::memory_resource`.
+ */
+using big_int = basic_big_int<std::pmr::polymorphic_allocator<limb_type>>;
+
+}
+
+}
+
+#endif // !GMATHS_INTEGERS_BIG_INT_HPP_INCLUDED
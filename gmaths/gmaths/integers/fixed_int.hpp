@@ -0,0 +1,389 @@
+#ifndef GMATHS_INTEGERS_FIXED_INT_HPP_INCLUDED
+#define GMATHS_INTEGERS_FIXED_INT_HPP_INCLUDED
+
+/**
+ * @file gmaths/integers/fixed_int.hpp
+ * @brief Provides integers of a fixed number of bits that behave like the
+ * builtin integer types.
+ *
+ * ::fixed_int stores its limbs in a `std::array` and implements all operators
+ * with the limb_span operations on static extents, so that no heap memory is
+ * needed and the operations on small widths compile to straight-line code.
+ */
+
+#include <gmaths/integers/limb_span/limb_span_add.hpp>
+#include <gmaths/integers/limb_span/limb_span_base.hpp>
+#include <gmaths/integers/limb_span/limb_span_bitwise.hpp>
+#include <gmaths/integers/limb_span/limb_span_compare.hpp>
+#include <gmaths/integers/limb_span/limb_span_div.hpp>
+#include <gmaths/integers/limb_span/limb_span_mul.hpp>
+#include <gmaths/integers/limb_span/limb_span_shift.hpp>
+
+#include <array>
+#include <compare>
+#include <concepts>
+#include <limits>
+#include <type_traits>
+
+namespace gmaths::integers
+{
+
+/**
+ * @brief Integer of exactly @p Bits bits in two's complement.
+ *
+ * The type is trivially copyable and all operations are `constexpr`. As with
+ * the builtin unsigned types, all arithmetic wraps around modulo `2^Bits`,
+ * which also applies to signed integers. Division truncates towards zero and
+ * the remainder has the sign of the dividend. Division by zero is undefined.
+ * Shifting by at least @p Bits bits yields zero, or all ones for negative
+ * signed integers shifted to the right.
+ *
+ * @tparam Bits number of bits, must be a positive multiple of ::limb_bits
+ * @tparam Signed whether the integer is signed
+ */
+template<std::size_t Bits, bool Signed = false>
+class fixed_int
+{
+    static_assert(Bits > 0 && Bits % limb_bits == 0, "fixed_int requires a positive multiple of limb_bits");
+
+    template<std::size_t, bool>
+    friend class fixed_int;
+
+public:
+    /**
+     * @brief Number of limbs of the integer.
+     */
+    static constexpr std::size_t limb_count = Bits / limb_bits;
+
+    /**
+     * @brief Initializes the integer with zero.
+     */
+    constexpr fixed_int() noexcept = default;
+
+    /**
+     * @brief Initializes the integer with the value of a builtin integer,
+     * which is sign extended if it is signed.
+     *
+     * Builtin integers wider than a limb, such as `__int128`, fill as many
+     * limbs as they have.
+     */
+    template<std::integral T>
+    constexpr fixed_int(T v) noexcept
+    {
+        constexpr std::size_t n = std::min(limb_count, builtin_limbs<T>);
+        if constexpr (n == 1) {
+            _limbs[0] = static_cast<limb_type>(v);
+        } else {
+            for (std::size_t k = 0; k < n; ++k) {
+                _limbs[k] = static_cast<limb_type>(v >> (k * limb_bits));
+            }
+        }
+        if constexpr (std::is_signed_v<T>) {
+            std::fill(_limbs.begin() + n, _limbs.end(), limb_span_sign_extension(std::span<const limb_type, n>(_limbs.data(), n)));
+        }
+    }
+
+    /**
+     * @brief Initializes the integer with the value of another ::fixed_int,
+     * which is truncated or extended according to its signedness.
+     *
+     * The conversion is implicit unless it truncates.
+     */
+    template<std::size_t B, bool S>
+    constexpr explicit(B > Bits) fixed_int(const fixed_int<B, S>& v) noexcept
+    {
+        constexpr std::size_t n = std::min(limb_count, fixed_int<B, S>::limb_count);
+        std::copy_n(v._limbs.begin(), n, _limbs.begin());
+        std::fill(_limbs.begin() + n, _limbs.end(), limb_span_sign_extension<S>(v.limbs()));
+    }
+
+    /**
+     * @brief Initializes the integer from its limbs, least significant first.
+     */
+    constexpr explicit fixed_int(const std::array<limb_type, limb_count>& limbs) noexcept : _limbs(limbs) { }
+
+    /**
+     * @brief Returns the low bits of the integer as a builtin integer.
+     *
+     * Builtin integers wider than the integer receive its sign extension.
+     */
+    template<std::integral T>
+    constexpr explicit operator T() const noexcept
+    {
+        if constexpr (builtin_limbs<T> == 1) {
+            return static_cast<T>(_limbs[0]);
+        } else {
+            limb_type ext = limb_span_sign_extension<Signed>(limbs());
+            std::make_unsigned_t<T> v = 0;
+            for (std::size_t k = 0; k < builtin_limbs<T>; ++k) {
+                v |= static_cast<std::make_unsigned_t<T>>(k < limb_count ? _limbs[k] : ext) << (k * limb_bits);
+            }
+            return static_cast<T>(v);
+        }
+    }
+
+    /**
+     * @brief Tests if the integer is non-zero.
+     */
+    constexpr explicit operator bool() const noexcept
+    {
+        return std::any_of(_limbs.begin(), _limbs.end(), [](limb_type l) { return l != 0; });
+    }
+
+    /**@{*/
+    /**
+     * @brief Returns the limbs of the integer, least significant first.
+     */
+    constexpr std::span<limb_type, limb_count> limbs() noexcept { return _limbs; }
+    constexpr std::span<const limb_type, limb_count> limbs() const noexcept { return _limbs; }
+    /**@}*/
+
+    /**
+     * @brief Returns the smallest value of the type.
+     */
+    static constexpr fixed_int min() noexcept
+    {
+        fixed_int r;
+        if constexpr (Signed) {
+            r._limbs.back() = limb_type(1) << (limb_bits - 1);
+        }
+        return r;
+    }
+
+    /**
+     * @brief Returns the largest value of the type.
+     */
+    static constexpr fixed_int max() noexcept
+    {
+        fixed_int r = ~fixed_int();
+        if constexpr (Signed) {
+            r._limbs.back() >>= 1;
+        }
+        return r;
+    }
+
+    /**@{*/
+    /**
+     * @brief Arithmetic operators, which wrap around modulo `2^Bits`.
+     */
+    constexpr fixed_int operator+() const noexcept { return *this; }
+    constexpr fixed_int operator-() const noexcept
+    {
+        fixed_int r;
+        limb_span_sub(r.limbs(), fixed_int().limbs(), limbs());
+        return r;
+    }
+
+    constexpr fixed_int& operator++() noexcept { limb_span_add_inplace(limbs(), limb_type(1)); return *this; }
+    constexpr fixed_int& operator--() noexcept { limb_span_sub_inplace(limbs(), limb_type(1)); return *this; }
+    constexpr fixed_int operator++(int) noexcept { fixed_int r = *this; ++*this; return r; }
+    constexpr fixed_int operator--(int) noexcept { fixed_int r = *this; --*this; return r; }
+
+    constexpr fixed_int& operator+=(const fixed_int& r) noexcept { limb_span_add_inplace(limbs(), r.limbs()); return *this; }
+    constexpr fixed_int& operator-=(const fixed_int& r) noexcept { limb_span_sub_inplace(limbs(), r.limbs()); return *this; }
+    constexpr fixed_int& operator*=(const fixed_int& r) noexcept { return *this = *this * r; }
+    constexpr fixed_int& operator/=(const fixed_int& r) noexcept { return *this = *this / r; }
+    constexpr fixed_int& operator%=(const fixed_int& r) noexcept { return *this = *this % r; }
+
+    friend constexpr fixed_int operator+(const fixed_int& l, const fixed_int& r) noexcept
+    {
+        fixed_int d;
+        limb_span_add(d.limbs(), l.limbs(), r.limbs());
+        return d;
+    }
+
+    friend constexpr fixed_int operator-(const fixed_int& l, const fixed_int& r) noexcept
+    {
+        fixed_int d;
+        limb_span_sub(d.limbs(), l.limbs(), r.limbs());
+        return d;
+    }
+
+    friend constexpr fixed_int operator*(const fixed_int& l, const fixed_int& r) noexcept
+    {
+        // the low half of the product does not depend on the signedness
+        fixed_int d;
+        std::array<limb_type, limb_span_mul_scratch_size(limb_count, limb_count, limb_count)> scratch{ };
+        limb_span_mul(d.limbs(), l.limbs(), r.limbs(), std::span<limb_type>(scratch));
+        return d;
+    }
+
+    friend constexpr fixed_int operator/(const fixed_int& l, const fixed_int& r) noexcept
+    {
+        fixed_int q;
+        fixed_int m;
+        divrem(q, m, l, r);
+        return q;
+    }
+
+    friend constexpr fixed_int operator%(const fixed_int& l, const fixed_int& r) noexcept
+    {
+        fixed_int q;
+        fixed_int m;
+        divrem(q, m, l, r);
+        return m;
+    }
+    /**@}*/
+
+    /**@{*/
+    /**
+     * @brief Bitwise operators.
+     */
+    constexpr fixed_int operator~() const noexcept
+    {
+        fixed_int r;
+        limb_span_bitnot(r.limbs(), limbs());
+        return r;
+    }
+
+    constexpr fixed_int& operator&=(const fixed_int& r) noexcept { limb_span_bitand_inplace(limbs(), r.limbs()); return *this; }
+    constexpr fixed_int& operator|=(const fixed_int& r) noexcept { limb_span_bitor_inplace(limbs(), r.limbs()); return *this; }
+    constexpr fixed_int& operator^=(const fixed_int& r) noexcept { limb_span_bitxor_inplace(limbs(), r.limbs()); return *this; }
+    constexpr fixed_int& operator<<=(std::size_t s) noexcept { limb_span_shl_inplace(limbs(), s); return *this; }
+    constexpr fixed_int& operator>>=(std::size_t s) noexcept { limb_span_shr_inplace<signed_option>(limbs(), s); return *this; }
+
+    friend constexpr fixed_int operator&(const fixed_int& l, const fixed_int& r) noexcept
+    {
+        fixed_int d;
+        limb_span_bitand(d.limbs(), l.limbs(), r.limbs());
+        return d;
+    }
+
+    friend constexpr fixed_int operator|(const fixed_int& l, const fixed_int& r) noexcept
+    {
+        fixed_int d;
+        limb_span_bitor(d.limbs(), l.limbs(), r.limbs());
+        return d;
+    }
+
+    friend constexpr fixed_int operator^(const fixed_int& l, const fixed_int& r) noexcept
+    {
+        fixed_int d;
+        limb_span_bitxor(d.limbs(), l.limbs(), r.limbs());
+        return d;
+    }
+
+    friend constexpr fixed_int operator<<(const fixed_int& l, std::size_t s) noexcept
+    {
+        fixed_int d;
+        limb_span_shl(d.limbs(), l.limbs(), s);
+        return d;
+    }
+
+    friend constexpr fixed_int operator>>(const fixed_int& l, std::size_t s) noexcept
+    {
+        fixed_int d;
+        limb_span_shr<signed_option>(d.limbs(), l.limbs(), s);
+        return d;
+    }
+    /**@}*/
+
+    /**@{*/
+    /**
+     * @brief Compares the values of the integers.
+     */
+    friend constexpr bool operator==(const fixed_int& l, const fixed_int& r) noexcept = default;
+
+    friend constexpr std::strong_ordering operator<=>(const fixed_int& l, const fixed_int& r) noexcept
+    {
+        return limb_span_compare_promoted<signed_option>(l.limbs(), r.limbs());
+    }
+    /**@}*/
+
+private:
+    /*
+     * Marks all operands as signed for signed integers.
+     */
+    static constexpr limb_span_option signed_option = Signed ? left_signed_option | right_signed_option : limb_span_option(0);
+
+    /*
+     * Number of limbs a builtin integer occupies.
+     */
+    template<typename T>
+    static constexpr std::size_t builtin_limbs = (sizeof(T) + sizeof(limb_type) - 1) / sizeof(limb_type);
+
+    /*
+     * Unsigned division of the magnitudes, the signs are applied afterwards.
+     */
+    static constexpr void divrem(fixed_int& q, fixed_int& m, const fixed_int& l, const fixed_int& r) noexcept
+    {
+        bool l_neg = Signed && limb_span_sign_extension(l.limbs());
+        bool r_neg = Signed && limb_span_sign_extension(r.limbs());
+        fixed_int la = l_neg ? -l : l;
+        fixed_int ra = r_neg ? -r : r;
+
+        std::array<limb_type, limb_span_divrem_scratch_size(limb_count, limb_count)> scratch{ };
+        limb_span_divrem(q.limbs(), m.limbs(), la.limbs(), ra.limbs(), std::span<limb_type>(scratch));
+        if (l_neg != r_neg) {
+            q = -q;
+        }
+        if (l_neg) {
+            m = -m;
+        }
+    }
+
+    std::array<limb_type, limb_count> _limbs{ };
+};
+
+/**@{*/
+/**
+ * @brief Common fixed width integer types.
+ */
+using uint128_t = fixed_int<128>;
+using uint256_t = fixed_int<256>;
+using uint512_t = fixed_int<512>;
+using uint1024_t = fixed_int<1024>;
+using int128_t = fixed_int<128, true>;
+using int256_t = fixed_int<256, true>;
+using int512_t = fixed_int<512, true>;
+using int1024_t = fixed_int<1024, true>;
+/**@}*/
+
+}
+
+/**
+ * @brief Properties of ::gmaths::integers::fixed_int like those of the builtin
+ * integer types.
+ */
+template<std::size_t Bits, bool Signed>
+class std::numeric_limits<gmaths::integers::fixed_int<Bits, Signed>>
+{
+    using type = gmaths::integers::fixed_int<Bits, Signed>;
+
+public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = Signed;
+    static constexpr bool is_integer = true;
+    static constexpr bool is_exact = true;
+    static constexpr bool is_bounded = true;
+    static constexpr bool is_modulo = true;
+    static constexpr int radix = 2;
+    static constexpr int digits = static_cast<int>(Bits) - Signed;
+    static constexpr int digits10 = static_cast<int>(digits * 30103LL / 100000);
+    static constexpr int max_digits10 = 0;
+    static constexpr int min_exponent = 0;
+    static constexpr int min_exponent10 = 0;
+    static constexpr int max_exponent = 0;
+    static constexpr int max_exponent10 = 0;
+    static constexpr bool has_infinity = false;
+    static constexpr bool has_quiet_NaN = false;
+    static constexpr bool has_signaling_NaN = false;
+    static constexpr std::float_denorm_style has_denorm = std::denorm_absent;
+    static constexpr bool has_denorm_loss = false;
+    static constexpr bool is_iec559 = false;
+    static constexpr bool traps = false;
+    static constexpr bool tinyness_before = false;
+    static constexpr std::float_round_style round_style = std::round_toward_zero;
+
+    static constexpr type min() noexcept { return type::min(); }
+    static constexpr type max() noexcept { return type::max(); }
+    static constexpr type lowest() noexcept { return type::min(); }
+    static constexpr type epsilon() noexcept { return type(); }
+    static constexpr type round_error() noexcept { return type(); }
+    static constexpr type infinity() noexcept { return type(); }
+    static constexpr type quiet_NaN() noexcept { return type(); }
+    static constexpr type signaling_NaN() noexcept { return type(); }
+    static constexpr type denorm_min() noexcept { return type(); }
+};
+
+#endif // !GMATHS_INTEGERS_FIXED_INT_HPP_INCLUDED
@@ -0,0 +1,637 @@
+#ifndef GMATHS_INTEGERS_LIMB_SPAN_ADD_HPP_INCLUDED
+#define GMATHS_INTEGERS_LIMB_SPAN_ADD_HPP_INCLUDED
+
+/**
+ * @file gmaths/integers/limb_span/limb_span_add.hpp
+ * @brief Provides addition and subtraction of the numeric values stored in
+ * limb_spans.
+ *
+ * All functions write the result into the destination span, extending the
+ * operands according to their signedness if the destination is larger and
+ * truncating the result if it is smaller. The return value is the carry
+ * (respectively borrow) bit out of the most significant limb of the
+ * destination.
+ *
+ * The destination may overlap with the operands only if the overlapping spans
+ * begin at the same address.
+ */
+
+#include <gmaths/integers/limb_span/limb_span_base.hpp>
+#include <gmaths/utility/kernel_dispatch.hpp>
+
+#include <memory>
+#include <utility>
+
+/**
+ * @def GMATHS_CARRY_LOOKAHEAD_MAX_LIMBS
+ * @brief Number of limbs up to which long additions and subtractions prefer
+ * the AVX-512 carry-lookahead kernel over the ADX kernel.
+ *
+ * The carry-lookahead kernel is faster as long as the operands are cached.
+ * Beyond the last level cache both kernels are bound by memory bandwidth and
+ * the ADX kernel was measured at 1.55-1.75 ns/limb against 1.6-1.9 ns/limb
+ * from 2^21 limbs on.
+ */
+#ifndef GMATHS_CARRY_LOOKAHEAD_MAX_LIMBS
+#define GMATHS_CARRY_LOOKAHEAD_MAX_LIMBS (std::size_t(1) << 21)
+#endif
+
+namespace gmaths::integers
+{
+
+namespace _detail_limb_span_add
+{
+
+struct add_carry
+{
+    constexpr bool operator()(bool carry, limb_type l, limb_type r, limb_type* result) const noexcept
+    {
+        return limb_add(carry, l, r, result);
+    }
+};
+
+struct sub_borrow
+{
+    constexpr bool operator()(bool borrow, limb_type l, limb_type r, limb_type* result) const noexcept
+    {
+        return limb_sub(borrow, l, r, result);
+    }
+};
+
+/*
+ * Runtime kernels for long carry chains. They operate on raw pointers and are
+ * selected once according to the features of the executing CPU.
+ */
+using carry_chain_kernel = bool (*)(limb_type*, const limb_type*, const limb_type*, bool, std::size_t) noexcept;
+
+/*
+ * Spans shorter than this are always handled inline. This keeps fixed size
+ * arithmetic free of indirect calls.
+ */
+constexpr std::size_t carry_chain_kernel_threshold = 32;
+
+template<bool Sub>
+inline bool carry_chain_portable(limb_type* d, const limb_type* l, const limb_type* r, bool carry, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        carry = Sub ? limb_sub(carry, l[i], r[i], &d[i]) : limb_add(carry, l[i], r[i], &d[i]);
+    }
+    return carry;
+}
+
+#if !defined(GMATHS_NO_INTRINSICS) && ((defined(_MSC_VER) && defined(_M_X64)) || (defined(__GNUC__) && defined(__x86_64__)))
+/*
+ * Adds (or subtracts) two independent halves of length `h` at once. The lower
+ * half runs on the carry flag via `adcx`, the upper half on the overflow flag
+ * via `adox`, so the two dependency chains can execute in parallel.
+ *
+ * Subtraction is performed as `l + ~r + 1`, i. e. the carry of the lower half
+ * is the negated borrow. The upper half always starts with a carry of 0, so
+ * the carry out of the lower half has to be added to it afterwards. Since
+ * that only happens if the upper result is all ones, the carry out of the
+ * whole operation is the disjunction of both carries.
+ *
+ * `h` must be a positive multiple of 4.
+ */
+template<bool Sub>
+inline bool carry_chain_dual_adx(limb_type* d, const limb_type* l, const limb_type* r, bool carry, std::size_t h) noexcept
+{
+    bool carry_lo = Sub ? !carry : carry;
+    bool carry_hi = false;
+#if defined(_MSC_VER)
+    unsigned char c0 = carry_lo;
+    unsigned char c1 = 0;
+    for (std::size_t i = 0; i < h; ++i) {
+        c0 = _addcarryx_u64(c0, l[i], Sub ? ~r[i] : r[i], &d[i]);
+        c1 = _addcarryx_u64(c1, l[h + i], Sub ? ~r[h + i] : r[h + i], &d[h + i]);
+    }
+    carry_lo = c0;
+    carry_hi = c1;
+#else
+    limb_type mask = 0 - static_cast<limb_type>(carry_lo);
+    long long i = -static_cast<long long>(h);
+    unsigned char c0 = 0;
+    unsigned char c1 = 0;
+    if constexpr (!Sub) {
+        asm volatile(
+            "xor %%eax, %%eax\n\t"
+            "mov $1, %%eax\n\t"
+            "adcx %[mask], %%rax\n\t"
+            "1:\n\t"
+            "mov (%[l0],%[i],8), %%rax\n\t"
+            "adcx (%[r0],%[i],8), %%rax\n\t"
+            "mov %%rax, (%[d0],%[i],8)\n\t"
+            "mov (%[l1],%[i],8), %%rdx\n\t"
+            "adox (%[r1],%[i],8), %%rdx\n\t"
+            "mov %%rdx, (%[d1],%[i],8)\n\t"
+            "mov 8(%[l0],%[i],8), %%rax\n\t"
+            "adcx 8(%[r0],%[i],8), %%rax\n\t"
+            "mov %%rax, 8(%[d0],%[i],8)\n\t"
+            "mov 8(%[l1],%[i],8), %%rdx\n\t"
+            "adox 8(%[r1],%[i],8), %%rdx\n\t"
+            "mov %%rdx, 8(%[d1],%[i],8)\n\t"
+            "mov 16(%[l0],%[i],8), %%rax\n\t"
+            "adcx 16(%[r0],%[i],8), %%rax\n\t"
+            "mov %%rax, 16(%[d0],%[i],8)\n\t"
+            "mov 16(%[l1],%[i],8), %%rdx\n\t"
+            "adox 16(%[r1],%[i],8), %%rdx\n\t"
+            "mov %%rdx, 16(%[d1],%[i],8)\n\t"
+            "mov 24(%[l0],%[i],8), %%rax\n\t"
+            "adcx 24(%[r0],%[i],8), %%rax\n\t"
+            "mov %%rax, 24(%[d0],%[i],8)\n\t"
+            "mov 24(%[l1],%[i],8), %%rdx\n\t"
+            "adox 24(%[r1],%[i],8), %%rdx\n\t"
+            "mov %%rdx, 24(%[d1],%[i],8)\n\t"
+            "lea 4(%[i]), %[i]\n\t"
+            "jrcxz 2f\n\t"
+            "jmp 1b\n"
+            "2:\n\t"
+            "setc %[c0]\n\t"
+            "seto %[c1]\n\t"
+            : [i] "+c"(i), [c0] "=r"(c0), [c1] "=r"(c1)
+            : [d0] "r"(d + h), [l0] "r"(l + h), [r0] "r"(r + h),
+              [d1] "r"(d + 2 * h), [l1] "r"(l + 2 * h), [r1] "r"(r + 2 * h),
+              [mask] "r"(mask)
+            : "rax", "rdx", "cc", "memory");
+    } else {
+        asm volatile(
+            "xor %%eax, %%eax\n\t"
+            "mov $1, %%eax\n\t"
+            "adcx %[mask], %%rax\n\t"
+            "1:\n\t"
+            "mov (%[r0],%[i],8), %%rax\n\t"
+            "not %%rax\n\t"
+            "adcx (%[l0],%[i],8), %%rax\n\t"
+            "mov %%rax, (%[d0],%[i],8)\n\t"
+            "mov (%[r1],%[i],8), %%rdx\n\t"
+            "not %%rdx\n\t"
+            "adox (%[l1],%[i],8), %%rdx\n\t"
+            "mov %%rdx, (%[d1],%[i],8)\n\t"
+            "mov 8(%[r0],%[i],8), %%rax\n\t"
+            "not %%rax\n\t"
+            "adcx 8(%[l0],%[i],8), %%rax\n\t"
+            "mov %%rax, 8(%[d0],%[i],8)\n\t"
+            "mov 8(%[r1],%[i],8), %%rdx\n\t"
+            "not %%rdx\n\t"
+            "adox 8(%[l1],%[i],8), %%rdx\n\t"
+            "mov %%rdx, 8(%[d1],%[i],8)\n\t"
+            "mov 16(%[r0],%[i],8), %%rax\n\t"
+            "not %%rax\n\t"
+            "adcx 16(%[l0],%[i],8), %%rax\n\t"
+            "mov %%rax, 16(%[d0],%[i],8)\n\t"
+            "mov 16(%[r1],%[i],8), %%rdx\n\t"
+            "not %%rdx\n\t"
+            "adox 16(%[l1],%[i],8), %%rdx\n\t"
+            "mov %%rdx, 16(%[d1],%[i],8)\n\t"
+            "mov 24(%[r0],%[i],8), %%rax\n\t"
+            "not %%rax\n\t"
+            "adcx 24(%[l0],%[i],8), %%rax\n\t"
+            "mov %%rax, 24(%[d0],%[i],8)\n\t"
+            "mov 24(%[r1],%[i],8), %%rdx\n\t"
+            "not %%rdx\n\t"
+            "adox 24(%[l1],%[i],8), %%rdx\n\t"
+            "mov %%rdx, 24(%[d1],%[i],8)\n\t"
+            "lea 4(%[i]), %[i]\n\t"
+            "jrcxz 2f\n\t"
+            "jmp 1b\n"
+            "2:\n\t"
+            "setc %[c0]\n\t"
+            "seto %[c1]\n\t"
+            : [i] "+c"(i), [c0] "=r"(c0), [c1] "=r"(c1)
+            : [d0] "r"(d + h), [l0] "r"(l + h), [r0] "r"(r + h),
+              [d1] "r"(d + 2 * h), [l1] "r"(l + 2 * h), [r1] "r"(r + 2 * h),
+              [mask] "r"(mask)
+            : "rax", "rdx", "cc", "memory");
+    }
+    carry_lo = c0;
+    carry_hi = c1;
+#endif
+    for (std::size_t i = h; carry_lo && i < 2 * h; ++i) {
+        carry_lo = limb_inc(d[i], &d[i]);
+    }
+    carry = carry_hi || carry_lo;
+    return Sub ? !carry : carry;
+}
+
+template<bool Sub>
+inline bool carry_chain_adx(limb_type* d, const limb_type* l, const limb_type* r, bool carry, std::size_t count) noexcept
+{
+    std::size_t h = count / 8 * 4;
+    if (h) {
+        carry = carry_chain_dual_adx<Sub>(d, l, r, carry, h);
+    }
+    return carry_chain_portable<Sub>(d + 2 * h, l + 2 * h, r + 2 * h, carry, count - 2 * h);
+}
+
+/*
+ * Carry-lookahead across the lanes of AVX-512 vectors. Every lane adds (or
+ * subtracts) its limbs without an incoming carry and reports whether it
+ * generates a carry and whether it would propagate one, that is whether its
+ * sum is all ones (its difference is zero). With the generate flags shifted
+ * into the lane above and the incoming carry in the lowest bit, adding the
+ * propagate flags as an integer carries exactly along the runs of propagating
+ * lanes, so the lanes that receive a carry are the bits that changed. The
+ * carry out of the top lane is the bit above them. A generating lane never
+ * propagates, so these bits never overlap.
+ *
+ * This leaves a serial dependency of a few scalar instructions per step of
+ * two vectors instead of one per limb.
+ */
+template<bool Sub>
+GMATHS_TARGET_AVX512 inline unsigned carry_lookahead_avx512(limb_type* d, const limb_type* l, const limb_type* r, unsigned carry, std::size_t i) noexcept
+{
+    __m512i a0 = _mm512_loadu_si512(l + i);
+    __m512i b0 = _mm512_loadu_si512(r + i);
+    __m512i a1 = _mm512_loadu_si512(l + i + 8);
+    __m512i b1 = _mm512_loadu_si512(r + i + 8);
+    __m512i s0, s1;
+    unsigned g, p;
+    if constexpr (Sub) {
+        s0 = _mm512_sub_epi64(a0, b0);
+        s1 = _mm512_sub_epi64(a1, b1);
+        g = _mm512_cmplt_epu64_mask(a0, b0) | (static_cast<unsigned>(_mm512_cmplt_epu64_mask(a1, b1)) << 8);
+        p = _mm512_testn_epi64_mask(s0, s0) | (static_cast<unsigned>(_mm512_testn_epi64_mask(s1, s1)) << 8);
+    } else {
+        __m512i ones = _mm512_set1_epi64(-1);
+        s0 = _mm512_add_epi64(a0, b0);
+        s1 = _mm512_add_epi64(a1, b1);
+        g = _mm512_cmplt_epu64_mask(s0, a0) | (static_cast<unsigned>(_mm512_cmplt_epu64_mask(s1, a1)) << 8);
+        p = _mm512_cmpeq_epi64_mask(s0, ones) | (static_cast<unsigned>(_mm512_cmpeq_epi64_mask(s1, ones)) << 8);
+    }
+    unsigned x = ((g << 1) | carry) + p;
+    unsigned c = x ^ p;
+    __m512i one = _mm512_set1_epi64(1);
+    __mmask8 c0 = static_cast<__mmask8>(c);
+    __mmask8 c1 = static_cast<__mmask8>(c >> 8);
+    if constexpr (Sub) {
+        s0 = _mm512_mask_sub_epi64(s0, c0, s0, one);
+        s1 = _mm512_mask_sub_epi64(s1, c1, s1, one);
+    } else {
+        s0 = _mm512_mask_add_epi64(s0, c0, s0, one);
+        s1 = _mm512_mask_add_epi64(s1, c1, s1, one);
+    }
+    _mm512_storeu_si512(d + i, s0);
+    _mm512_storeu_si512(d + i + 8, s1);
+    return (x >> 16) & 1;
+}
+
+template<bool Sub>
+GMATHS_TARGET_AVX512 inline bool carry_chain_avx512(limb_type* d, const limb_type* l, const limb_type* r, bool carry, std::size_t count) noexcept
+{
+    unsigned c = carry;
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        c = carry_lookahead_avx512<Sub>(d, l, r, c, i);
+    }
+    return carry_chain_portable<Sub>(d + i, l + i, r + i, c != 0, count - i);
+}
+#endif
+
+/*
+ * Chains longer than GMATHS_CARRY_LOOKAHEAD_MAX_LIMBS are selected
+ * separately, they prefer the ADX kernel.
+ */
+template<bool Sub, bool Long>
+inline carry_chain_kernel select_carry_chain_kernel() noexcept
+{
+#if !defined(GMATHS_NO_INTRINSICS) && ((defined(_MSC_VER) && defined(_M_X64)) || (defined(__GNUC__) && defined(__x86_64__)))
+    const utility::kernel_variant<carry_chain_kernel> lookahead = { "avx512", utility::cpu_features{ .avx512f = true }, &carry_chain_avx512<Sub> };
+    const utility::kernel_variant<carry_chain_kernel> adx = { "adx", utility::cpu_features{ .adx = true }, &carry_chain_adx<Sub> };
+#endif
+    const utility::kernel_variant<carry_chain_kernel> variants[] = {
+#if !defined(GMATHS_NO_INTRINSICS) && ((defined(_MSC_VER) && defined(_M_X64)) || (defined(__GNUC__) && defined(__x86_64__)))
+        Long ? adx : lookahead,
+        Long ? lookahead : adx,
+#endif
+        { "portable", utility::cpu_features{ }, &carry_chain_portable<Sub> },
+    };
+    return utility::select_kernel(Long ? "long_carry_chain" : "carry_chain", Sub ? "sub" : "add", variants);
+}
+
+template<bool Sub>
+inline carry_chain_kernel runtime_carry_chain_kernel(std::size_t count) noexcept
+{
+    static const carry_chain_kernel kernel = select_carry_chain_kernel<Sub, false>();
+    static const carry_chain_kernel long_kernel = select_carry_chain_kernel<Sub, true>();
+    return count > GMATHS_CARRY_LOOKAHEAD_MAX_LIMBS ? long_kernel : kernel;
+}
+
+template<std::size_t N, typename DIt, typename LIt, typename RIt, typename Func>
+constexpr bool carry_chain(DIt d, LIt l, RIt r, bool carry, Func f, std::size_t count) noexcept
+{
+    if constexpr (N != std::dynamic_extent) {
+        count = N;
+    }
+
+#ifndef GMATHS_NO_INTRINSICS
+    if constexpr ((N == std::dynamic_extent || N >= carry_chain_kernel_threshold)
+        && (std::is_same_v<Func, add_carry> || std::is_same_v<Func, sub_borrow>)) {
+        if (!std::is_constant_evaluated() && count >= carry_chain_kernel_threshold) {
+            constexpr bool Sub = std::is_same_v<Func, sub_borrow>;
+            return runtime_carry_chain_kernel<Sub>(count)(std::to_address(d), std::to_address(l), std::to_address(r), carry, count);
+        }
+    }
+#endif
+
+    limb_type tmp = 0;
+    if constexpr (N != std::dynamic_extent && N < carry_chain_kernel_threshold) {
+        // short fixed chains are spelled out, compilers do not reliably unroll them
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((carry = f(carry, l[I], r[I], &tmp), d[I] = tmp), ...);
+        }(std::make_index_sequence<N>());
+    } else {
+        for (; count > 0; --count, ++d, ++l, ++r) {
+            carry = f(carry, *l, *r, &tmp);
+            *d = tmp;
+        }
+    }
+    return carry;
+}
+
+template<typename DIt, typename LIt, typename Func>
+constexpr bool carry_chain(DIt d, LIt l, limb_type r, bool carry, Func f, std::size_t count) noexcept
+{
+    limb_type tmp = 0;
+    for (; count > 0; --count, ++d, ++l) {
+        carry = f(carry, *l, r, &tmp);
+        *d = tmp;
+    }
+    return carry;
+}
+
+template<typename DIt, typename RIt, typename Func>
+constexpr bool carry_chain(DIt d, limb_type l, RIt r, bool carry, Func f, std::size_t count) noexcept
+{
+    limb_type tmp = 0;
+    for (; count > 0; --count, ++d, ++r) {
+        carry = f(carry, l, *r, &tmp);
+        *d = tmp;
+    }
+    return carry;
+}
+
+/*
+ * Fills the limbs beyond both operands. Since both operands only consist of
+ * their sign extensions in this region, the carry bit is stable after the first
+ * limb and so is every limb after that. So we only compute two limbs and fill
+ * the rest.
+ */
+template<typename DIt, typename Func>
+constexpr bool carry_fill(DIt d, limb_type l, limb_type r, bool carry, Func f, std::size_t count) noexcept
+{
+    if (count == 0) {
+        return carry;
+    }
+
+    limb_type tmp = 0;
+    carry = f(carry, l, r, &tmp);
+    *d = tmp;
+    ++d;
+    carry = f(carry, l, r, &tmp);
+    std::fill_n(d, count - 1, tmp);
+    return carry;
+}
+
+/*
+ * Applies the sign extension of the right operand to the remaining limbs of
+ * an in-place operation.
+ *
+ * `x + 0 + 0`, `x + ~0 + 1`, `x - 0 - 0` and `x - ~0 - 1` all leave `x`
+ * unchanged and reproduce the incoming carry, so the propagation can stop as
+ * soon as the carry equals the sign bit of the extension.
+ *
+ * If the caller promised that the result does not overflow, an unsigned carry
+ * is guaranteed to be absorbed before the end of the span which removes the
+ * need for bounds checks.
+ */
+template<bool Branchless, bool NoOverflow, bool RSigned, typename DIt, typename Func>
+constexpr bool carry_propagate(DIt d, limb_type r, bool carry, Func f, std::size_t count) noexcept
+{
+    if constexpr (NoOverflow && !RSigned && !Branchless) {
+        while (carry) {
+            limb_type tmp = 0;
+            carry = f(carry, *d, 0, &tmp);
+            *d = tmp;
+            ++d;
+        }
+        return false;
+    } else {
+        limb_type tmp = 0;
+        for (; count > 0; --count, ++d) {
+            if constexpr (!Branchless) {
+                if (carry == static_cast<bool>(r)) {
+                    break;
+                }
+            }
+            carry = f(carry, *d, r, &tmp);
+            *d = tmp;
+        }
+        return carry;
+    }
+}
+
+template<bool LSigned, bool RSigned, output_limb_span D, input_limb_span L, input_limb_span R, typename Func>
+constexpr bool binary(D d, L l, R r, Func f) noexcept
+{
+    constexpr std::size_t DN = D::extent;
+    constexpr std::size_t LN = L::extent;
+    constexpr std::size_t RN = R::extent;
+
+    constexpr std::size_t N = span_utils::min_extent({DN, LN, RN});
+
+    // d may begin at an operand, so the extensions are read before d is written
+    limb_type lext = limb_span_sign_extension<LSigned>(l);
+    limb_type rext = limb_span_sign_extension<RSigned>(r);
+
+    std::size_t minSize = std::min({d.size(), l.size(), r.size()});
+    bool carry = carry_chain<N>(d.begin(), l.begin(), r.begin(), false, f, minSize);
+    if constexpr (std::max({DN, LN, RN}) == std::dynamic_extent || DN > LN || DN > RN) {
+        if (d.size() <= minSize) {
+            return carry;
+        }
+
+        if constexpr (RN == std::dynamic_extent || (LN > RN && DN > RN)) {
+            if (l.size() > r.size()) {
+                std::size_t n = std::min(d.size(), l.size()) - r.size();
+                carry = carry_chain(d.begin() + r.size(), l.begin() + r.size(), rext, carry, f, n);
+            }
+        }
+
+        if constexpr (LN == std::dynamic_extent || (RN > LN && DN > LN)) {
+            if (l.size() < r.size()) {
+                std::size_t n = std::min(d.size(), r.size()) - l.size();
+                carry = carry_chain(d.begin() + l.size(), lext, r.begin() + l.size(), carry, f, n);
+            }
+        }
+
+        std::size_t maxSize = std::max(l.size(), r.size());
+        if (d.size() > maxSize) {
+            carry = carry_fill(d.begin() + maxSize, lext, rext, carry, f, d.size() - maxSize);
+        }
+    }
+    return carry;
+}
+
+template<bool Branchless, bool NoOverflow, bool RSigned, output_limb_span D, input_limb_span R, typename Func>
+constexpr bool binary_inplace(D d, R r, Func f) noexcept
+{
+    constexpr std::size_t DN = D::extent;
+    constexpr std::size_t RN = R::extent;
+
+    constexpr std::size_t N = span_utils::min_extent({DN, RN});
+
+    // r may begin at d, so its extension is read before d is written
+    limb_type rext = limb_span_sign_extension<RSigned>(r);
+
+    std::size_t minSize = std::min(d.size(), r.size());
+    bool carry = carry_chain<N>(d.begin(), d.begin(), r.begin(), false, f, minSize);
+    if constexpr (std::max(DN, RN) == std::dynamic_extent || DN > RN) {
+        if (d.size() <= r.size()) {
+            return carry;
+        }
+
+        carry = carry_propagate<Branchless, NoOverflow, RSigned>(d.begin() + r.size(), rext, carry, f, d.size() - r.size());
+    }
+    return carry;
+}
+
+template<limb_span_option Opt, output_limb_span D, input_limb_span L, input_limb_span R, typename Func>
+constexpr bool binary_dispatch(D d, L l, R r, Func f) noexcept
+{
+    constexpr bool LSigned = static_cast<bool>(Opt & left_signed_option);
+    constexpr bool RSigned = static_cast<bool>(Opt & right_signed_option);
+    std::span<const limb_type, L::extent> l2 = l;
+    std::span<const limb_type, R::extent> r2 = r;
+    return _detail_limb_span_add::binary<LSigned, RSigned>(d, l2, r2, f);
+}
+
+template<limb_span_option Opt, output_limb_span D, input_limb_span R, typename Func>
+constexpr bool binary_inplace_dispatch(D d, R r, Func f) noexcept
+{
+    constexpr bool Branchless = static_cast<bool>(Opt & branchless_option);
+    constexpr bool NoOverflow = static_cast<bool>(Opt & no_overflow_option);
+    constexpr bool RSigned = static_cast<bool>(Opt & right_signed_option);
+    std::span<const limb_type, R::extent> r2 = r;
+    return _detail_limb_span_add::binary_inplace<Branchless, NoOverflow, RSigned>(d, r2, f);
+}
+
+}
+
+/**
+ * @brief Computes the sum of @p l and @p r and stores it in @p d.
+ *
+ * @tparam Opt tests for ::left_signed_option and ::right_signed_option
+ * @param d destination of the sum
+ * @param l first summand
+ * @param r second summand
+ * @return the carry bit out of the most significant limb of @p d
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R>
+constexpr bool limb_span_add(D d, L l, R r) noexcept
+{
+    _detail_limb_span_add::add_carry func{ };
+    return _detail_limb_span_add::binary_dispatch<Opt>(d, l, r, func);
+}
+
+/**
+ * @brief Computes the sum of @p l and the single limb @p r and stores it in
+ * @p d.
+ *
+ * @p r is treated as a limb_span of size 1, so ::right_signed_option applies.
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L>
+constexpr bool limb_span_add(D d, L l, limb_type r) noexcept
+{
+    return limb_span_add<Opt>(d, l, std::span<const limb_type, 1>(&r, 1));
+}
+
+/**
+ * @brief Adds @p r to @p d.
+ *
+ * The propagation of the carry beyond the limbs of @p r stops as soon as the
+ * remaining limbs of @p d are known to be unchanged, unless
+ * ::branchless_option is set. If ::no_overflow_option is set and @p r is
+ * unsigned, the propagation is not bounds checked at all.
+ *
+ * @tparam Opt tests for ::right_signed_option, ::branchless_option and
+ * ::no_overflow_option
+ * @param d first summand and destination of the sum
+ * @param r second summand
+ * @return the carry bit out of the most significant limb of @p d
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span R>
+constexpr bool limb_span_add_inplace(D d, R r) noexcept
+{
+    _detail_limb_span_add::add_carry func{ };
+    return _detail_limb_span_add::binary_inplace_dispatch<Opt>(d, r, func);
+}
+
+/**
+ * @brief Adds the single limb @p r to @p d.
+ *
+ * @p r is treated as a limb_span of size 1, so ::right_signed_option applies.
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D>
+constexpr bool limb_span_add_inplace(D d, limb_type r) noexcept
+{
+    return limb_span_add_inplace<Opt>(d, std::span<const limb_type, 1>(&r, 1));
+}
+
+/**
+ * @brief Computes the difference of @p l and @p r and stores it in @p d.
+ *
+ * @tparam Opt tests for ::left_signed_option and ::right_signed_option
+ * @param d destination of the difference
+ * @param l minuend
+ * @param r subtrahend
+ * @return the borrow bit out of the most significant limb of @p d
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R>
+constexpr bool limb_span_sub(D d, L l, R r) noexcept
+{
+    _detail_limb_span_add::sub_borrow func{ };
+    return _detail_limb_span_add::binary_dispatch<Opt>(d, l, r, func);
+}
+
+/**
+ * @brief Computes the difference of @p l and the single limb @p r and stores
+ * it in @p d.
+ *
+ * @p r is treated as a limb_span of size 1, so ::right_signed_option applies.
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L>
+constexpr bool limb_span_sub(D d, L l, limb_type r) noexcept
+{
+    return limb_span_sub<Opt>(d, l, std::span<const limb_type, 1>(&r, 1));
+}
+
+/**
+ * @brief Subtracts @p r from @p d.
+ *
+ * Options are handled the same as in ::limb_span_add_inplace().
+ *
+ * @param d minuend and destination of the difference
+ * @param r subtrahend
+ * @return the borrow bit out of the most significant limb of @p d
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span R>
+constexpr bool limb_span_sub_inplace(D d, R r) noexcept
+{
+    _detail_limb_span_add::sub_borrow func{ };
+    return _detail_limb_span_add::binary_inplace_dispatch<Opt>(d, r, func);
+}
+
+/**
+ * @brief Subtracts the single limb @p r from @p d.
+ *
+ * @p r is treated as a limb_span of size 1, so ::right_signed_option applies.
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D>
+constexpr bool limb_span_sub_inplace(D d, limb_type r) noexcept
+{
+    return limb_span_sub_inplace<Opt>(d, std::span<const limb_type, 1>(&r, 1));
+}
+
+}
+
+#endif // !GMATHS_INTEGERS_LIMB_SPAN_ADD_HPP_INCLUDED
@@ -0,0 +1,170 @@
+#ifndef GMATHS_INTEGERS_LIMB_SPAN_BARRETT_HPP_INCLUDED
+#define GMATHS_INTEGERS_LIMB_SPAN_BARRETT_HPP_INCLUDED
+
+/**
+ * @file gmaths/integers/limb_span/limb_span_barrett.hpp
+ * @brief Provides Barrett reduction modulo a fixed modulus of a fixed number
+ * of limbs.
+ *
+ * Unlike Montgomery multiplication, Barrett reduction works for any modulus
+ * and on values in their usual representation. ::barrett_context precomputes
+ * `floor(B^(2 * N) / m)` with `B = 2^limb_bits`, which replaces each division
+ * by the modulus with two multiplications.
+ */
+
+#include <gmaths/integers/limb_span/limb_span_base.hpp>
+#include <gmaths/integers/limb_span/limb_span_div.hpp>
+#include <gmaths/integers/limb_span/limb_span_montgomery.hpp>
+#include <gmaths/integers/limb_span/limb_span_mul.hpp>
+
+#include <array>
+
+namespace gmaths::integers
+{
+
+/**
+ * @brief Precomputed constants for Barrett reduction modulo a modulus of
+ * @p N limbs.
+ *
+ * All operations take values of exactly @p N limbs which must be less than
+ * the modulus, unless noted otherwise. Since @p N is known at compile time,
+ * the corrections are fully unrolled. Destinations may overlap with the
+ * operands.
+ *
+ * @tparam N number of limbs of the modulus
+ */
+template<std::size_t N>
+class barrett_context
+{
+    static_assert(N > 0 && N != std::dynamic_extent, "barrett_context requires a static extent");
+
+public:
+    /**
+     * @brief Type of the values the context operates on.
+     */
+    using span_type = std::span<limb_type, N>;
+
+    /**
+     * @brief Type of the read only values the context operates on.
+     */
+    using const_span_type = std::span<const limb_type, N>;
+
+    /**
+     * @brief Precomputes `floor(B^(2 * N) / m)`.
+     *
+     * The behavior is undefined if the top limb of @p m is zero.
+     *
+     * @param m the modulus.
+     */
+    constexpr explicit barrett_context(const_span_type m)
+    {
+        assert(m[N - 1] != 0);
+        std::copy(m.begin(), m.end(), _modulus.begin());
+
+        std::array<limb_type, 2 * N + 1> b{ };
+        b[2 * N] = 1;
+        std::array<limb_type, N + 2> q{ };
+        std::array<limb_type, N> r{ };
+        limb_span_divrem(std::span<limb_type>(q), std::span<limb_type>(r), std::span<const limb_type>(b), m);
+
+        // only B^(N - 1) itself has a reciprocal that exceeds N + 1 limbs,
+        // and reducing by it merely truncates
+        _truncate = q[N + 1] != 0;
+        std::copy_n(q.begin(), N + 1, _reciprocal.begin());
+        _one[0] = N > 1 || m[0] > 1;
+    }
+
+    /**
+     * @brief Returns the modulus.
+     */
+    constexpr const_span_type modulus() const noexcept { return const_span_type(_modulus); }
+
+    /**
+     * @brief Returns `1 mod m`.
+     */
+    constexpr const_span_type one() const noexcept { return const_span_type(_one); }
+
+    /**
+     * @brief Computes `x mod m` and stores it in @p d.
+     *
+     * The estimate `floor(floor(x / B^(N - 1)) * mu / B^(N + 1))` of the
+     * quotient is at most two less than the actual quotient, so the remainder
+     * is corrected with two conditional subtractions, which are computed
+     * without branches.
+     *
+     * @param d destination of the remainder
+     * @param x double width value to reduce
+     */
+    constexpr void reduce(span_type d, std::span<const limb_type, 2 * N> x) const noexcept
+    {
+        using _detail_limb_span_montgomery::unrolled;
+        using _detail_limb_span_montgomery::final_subtract;
+
+        if (_truncate) {
+            std::copy_n(x.begin(), N - 1, d.begin());
+            d[N - 1] = 0;
+            return;
+        }
+
+        std::array<limb_type, 2 * N + 2> q2;
+        constexpr std::size_t scratch_size = std::max(limb_span_mul_scratch_size(2 * N + 2, N + 1, N + 1), limb_span_mul_scratch_size(N + 1, N + 1, N));
+        std::array<limb_type, scratch_size> scratch;
+        limb_span_mul(std::span<limb_type, 2 * N + 2>(q2), std::span<const limb_type, N + 1>(x.data() + N - 1, N + 1), std::span<const limb_type, N + 1>(_reciprocal), std::span<limb_type>(scratch));
+
+        // only the low N + 1 limbs of the remainder and q3 * m are needed, as
+        // the remainder is less than 3 * m
+        std::array<limb_type, N + 1> r2;
+        limb_span_mul(std::span<limb_type, N + 1>(r2), std::span<const limb_type, N + 1>(q2.data() + N + 1, N + 1), modulus(), std::span<limb_type>(scratch));
+
+        std::array<limb_type, N + 1> r;
+        bool borrow = false;
+        unrolled<N + 1>([&](auto j) {
+            borrow = limb_sub(borrow, x[j], r2[j], &r[j]);
+        });
+
+        std::array<limb_type, N + 1> m{ };
+        std::copy(_modulus.begin(), _modulus.end(), m.begin());
+        final_subtract<N + 1>(std::span<limb_type, N + 1>(r), r, 0, m);
+        final_subtract<N + 1>(std::span<limb_type, N + 1>(r), r, 0, m);
+        std::copy_n(r.begin(), N, d.begin());
+    }
+
+    /**
+     * @brief Computes `l * r mod m` and stores it in @p d.
+     *
+     * @param d destination of the product
+     * @param l first factor
+     * @param r second factor
+     */
+    constexpr void mul(span_type d, const_span_type l, const_span_type r) const noexcept
+    {
+        std::array<limb_type, 2 * N> t;
+        std::array<limb_type, limb_span_mul_scratch_size(2 * N, N, N)> scratch;
+        limb_span_mul(std::span<limb_type, 2 * N>(t), l, r, std::span<limb_type>(scratch));
+        reduce(d, t);
+    }
+
+    /**
+     * @brief Computes `l * l mod m` and stores it in @p d.
+     *
+     * @param d destination of the square
+     * @param l operand
+     */
+    constexpr void sqr(span_type d, const_span_type l) const noexcept
+    {
+        std::array<limb_type, 2 * N> t;
+        std::array<limb_type, limb_span_sqr_scratch_size(2 * N, N)> scratch;
+        limb_span_sqr(std::span<limb_type, 2 * N>(t), l, std::span<limb_type>(scratch));
+        reduce(d, t);
+    }
+
+private:
+    std::array<limb_type, N> _modulus{ };
+    std::array<limb_type, N + 1> _reciprocal{ };
+    std::array<limb_type, N> _one{ };
+    bool _truncate = false;
+};
+
+}
+
+#endif // !GMATHS_INTEGERS_LIMB_SPAN_BARRETT_HPP_INCLUDED
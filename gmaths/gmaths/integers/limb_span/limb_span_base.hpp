@@ -20,6 +20,21 @@
 #include <span>
 #include <type_traits>
 
+/**
+ * @def GMATHS_RESTRICT
+ * @brief Qualifies a pointer as the only means of access to the limbs it
+ * points to within a function, like `restrict` in C.
+ *
+ * Used by the loops that run when the restrict options promise that the
+ * destination does not overlap with the operands. Expands to nothing if
+ * ::GMATHS_NO_INTRINSICS is defined.
+ */
+#if !defined(GMATHS_NO_INTRINSICS) && (defined(_MSC_VER) || defined(__GNUC__))
+#define GMATHS_RESTRICT __restrict
+#else
+#define GMATHS_RESTRICT
+#endif
+
 namespace gmaths::integers
 {
 
@@ -217,6 +232,9 @@ constexpr limb_span_option arg_mutable_option(0x20);
  * even when these options are not set. Overlap is only allowed if the
  * overlapping spans begin at the same address.
  * 
+ * The bitwise operations process the limbs of non-overlapping spans in loops
+ * over ::GMATHS_RESTRICT pointers, which the compiler can vectorize.
+ * 
  * Use with mutable options for maximum impact.
  */
 constexpr limb_span_option restrict_left_right_option(0x1000);
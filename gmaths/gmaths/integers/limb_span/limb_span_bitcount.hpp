@@ -0,0 +1,398 @@
+#ifndef GMATHS_INTEGERS_LIMB_SPAN_BITCOUNT_HPP_INCLUDED
+#define GMATHS_INTEGERS_LIMB_SPAN_BITCOUNT_HPP_INCLUDED
+
+/**
+ * @file gmaths/integers/limb_span/limb_span_bitcount.hpp
+ * @brief Provides functions that count the bits of the values stored in
+ * limb_spans: population count, leading and trailing zeroes, bit width and
+ * Hamming distance.
+ *
+ * Population counts of long spans are computed by runtime kernels selected
+ * through ::gmaths::utility::select_kernel(), the fastest one sums the bits of
+ * 64 limbs with a Harley-Seal carry-save adder tree of AVX2 registers.
+ */
+
+#include <gmaths/integers/limb_span/limb_span_base.hpp>
+#include <gmaths/utility/kernel_dispatch.hpp>
+
+#include <memory>
+#include <type_traits>
+
+#if !defined(GMATHS_NO_INTRINSICS) && ((defined(_MSC_VER) && defined(_M_X64)) || (defined(__GNUC__) && defined(__x86_64__)))
+#include <immintrin.h>
+#endif
+
+namespace gmaths::integers
+{
+
+namespace _detail_limb_span_bitcount
+{
+
+/*
+ * Runtime kernels count the 1 bits of l, or of l ^ r if Xor is set, for count
+ * limbs. r is not accessed otherwise.
+ */
+using count_kernel = std::size_t (*)(const limb_type*, const limb_type*, std::size_t) noexcept;
+
+/*
+ * Spans shorter than this are always counted inline. The threshold is lower
+ * than for the other kernels since without the popcnt instruction each limb
+ * costs about a dozen instructions.
+ */
+constexpr std::size_t count_kernel_threshold = 8;
+
+template<bool Xor>
+constexpr limb_type load(const limb_type* l, const limb_type* r, std::size_t i) noexcept
+{
+    if constexpr (Xor) {
+        return l[i] ^ r[i];
+    } else {
+        static_cast<void>(r);
+        return l[i];
+    }
+}
+
+/*
+ * Carry-save adder, adds three bit vectors to a vector of sums (returned) and a
+ * vector of carries (h).
+ */
+constexpr limb_type csa(limb_type& h, limb_type a, limb_type b, limb_type c) noexcept
+{
+    limb_type u = a ^ b;
+    h = (a & b) | (u & c);
+    return u ^ c;
+}
+
+/*
+ * Harley-Seal population count: 16 limbs are reduced to a single limb of
+ * weight 16 by carry-save adders, so only one in 16 limbs is counted.
+ */
+template<bool Xor>
+inline std::size_t count_portable(const limb_type* l, const limb_type* r, std::size_t count) noexcept
+{
+    std::size_t total = 0;
+    limb_type ones = 0, twos = 0, fours = 0, eights = 0;
+    limb_type twos_a, twos_b, fours_a, fours_b, eights_a, eights_b, sixteens;
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        ones = csa(twos_a, ones, load<Xor>(l, r, i + 0), load<Xor>(l, r, i + 1));
+        ones = csa(twos_b, ones, load<Xor>(l, r, i + 2), load<Xor>(l, r, i + 3));
+        twos = csa(fours_a, twos, twos_a, twos_b);
+        ones = csa(twos_a, ones, load<Xor>(l, r, i + 4), load<Xor>(l, r, i + 5));
+        ones = csa(twos_b, ones, load<Xor>(l, r, i + 6), load<Xor>(l, r, i + 7));
+        twos = csa(fours_b, twos, twos_a, twos_b);
+        fours = csa(eights_a, fours, fours_a, fours_b);
+        ones = csa(twos_a, ones, load<Xor>(l, r, i + 8), load<Xor>(l, r, i + 9));
+        ones = csa(twos_b, ones, load<Xor>(l, r, i + 10), load<Xor>(l, r, i + 11));
+        twos = csa(fours_a, twos, twos_a, twos_b);
+        ones = csa(twos_a, ones, load<Xor>(l, r, i + 12), load<Xor>(l, r, i + 13));
+        ones = csa(twos_b, ones, load<Xor>(l, r, i + 14), load<Xor>(l, r, i + 15));
+        twos = csa(fours_b, twos, twos_a, twos_b);
+        fours = csa(eights_b, fours, fours_a, fours_b);
+        eights = csa(sixteens, eights, eights_a, eights_b);
+        total += limb_popcount(sixteens);
+    }
+
+    total = 16 * total + 8 * limb_popcount(eights) + 4 * limb_popcount(fours) + 2 * limb_popcount(twos) + limb_popcount(ones);
+    for (; i < count; ++i) {
+        total += limb_popcount(load<Xor>(l, r, i));
+    }
+    return total;
+}
+
+#if !defined(GMATHS_NO_INTRINSICS) && ((defined(_MSC_VER) && defined(_M_X64)) || (defined(__GNUC__) && defined(__x86_64__)))
+/*
+ * One popcnt instruction per limb, with four accumulators so that the
+ * additions do not form a single dependency chain.
+ */
+template<bool Xor>
+GMATHS_TARGET_POPCNT inline std::size_t count_popcnt(const limb_type* l, const limb_type* r, std::size_t count) noexcept
+{
+    std::size_t t0 = 0, t1 = 0, t2 = 0, t3 = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        t0 += static_cast<std::size_t>(_mm_popcnt_u64(load<Xor>(l, r, i + 0)));
+        t1 += static_cast<std::size_t>(_mm_popcnt_u64(load<Xor>(l, r, i + 1)));
+        t2 += static_cast<std::size_t>(_mm_popcnt_u64(load<Xor>(l, r, i + 2)));
+        t3 += static_cast<std::size_t>(_mm_popcnt_u64(load<Xor>(l, r, i + 3)));
+    }
+    for (; i < count; ++i) {
+        t0 += static_cast<std::size_t>(_mm_popcnt_u64(load<Xor>(l, r, i)));
+    }
+    return t0 + t1 + t2 + t3;
+}
+
+/*
+ * Harley-Seal over AVX2 registers, 64 limbs per iteration. The bytes of the
+ * register of weight 16 are counted by looking up the counts of their nibbles
+ * with vpshufb and summed by vpsadbw (Mula, Kurz and Lemire).
+ */
+struct avx2_isa
+{
+    static constexpr std::size_t width = 4;
+
+    template<bool Xor>
+    GMATHS_TARGET_AVX2 static __m256i load(const limb_type* l, const limb_type* r, std::size_t i) noexcept
+    {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l + i));
+        if constexpr (Xor) {
+            a = _mm256_xor_si256(a, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + i)));
+        }
+        return a;
+    }
+
+    GMATHS_TARGET_AVX2 static __m256i csa(__m256i& h, __m256i a, __m256i b, __m256i c) noexcept
+    {
+        __m256i u = _mm256_xor_si256(a, b);
+        h = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+        return _mm256_xor_si256(u, c);
+    }
+
+    /* Counts of the four limbs of v. */
+    GMATHS_TARGET_AVX2 static __m256i popcount(__m256i v) noexcept
+    {
+        const __m256i lookup = _mm256_setr_epi8(
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i nibble = _mm256_set1_epi8(0x0f);
+        __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, nibble));
+        __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+    }
+
+    template<bool Xor>
+    GMATHS_TARGET_AVX2 static std::size_t count(const limb_type* l, const limb_type* r, std::size_t count) noexcept
+    {
+        constexpr std::size_t w = width;
+        if (count < 16 * w) {
+            return count_popcnt<Xor>(l, r, count);
+        }
+
+        __m256i total = _mm256_setzero_si256();
+        __m256i ones = _mm256_setzero_si256(), twos = ones, fours = ones, eights = ones;
+        __m256i twos_a, twos_b, fours_a, fours_b, eights_a, eights_b, sixteens;
+
+        std::size_t i = 0;
+        for (; i + 16 * w <= count; i += 16 * w) {
+            ones = csa(twos_a, ones, load<Xor>(l, r, i + 0 * w), load<Xor>(l, r, i + 1 * w));
+            ones = csa(twos_b, ones, load<Xor>(l, r, i + 2 * w), load<Xor>(l, r, i + 3 * w));
+            twos = csa(fours_a, twos, twos_a, twos_b);
+            ones = csa(twos_a, ones, load<Xor>(l, r, i + 4 * w), load<Xor>(l, r, i + 5 * w));
+            ones = csa(twos_b, ones, load<Xor>(l, r, i + 6 * w), load<Xor>(l, r, i + 7 * w));
+            twos = csa(fours_b, twos, twos_a, twos_b);
+            fours = csa(eights_a, fours, fours_a, fours_b);
+            ones = csa(twos_a, ones, load<Xor>(l, r, i + 8 * w), load<Xor>(l, r, i + 9 * w));
+            ones = csa(twos_b, ones, load<Xor>(l, r, i + 10 * w), load<Xor>(l, r, i + 11 * w));
+            twos = csa(fours_a, twos, twos_a, twos_b);
+            ones = csa(twos_a, ones, load<Xor>(l, r, i + 12 * w), load<Xor>(l, r, i + 13 * w));
+            ones = csa(twos_b, ones, load<Xor>(l, r, i + 14 * w), load<Xor>(l, r, i + 15 * w));
+            twos = csa(fours_b, twos, twos_a, twos_b);
+            fours = csa(eights_b, fours, fours_a, fours_b);
+            eights = csa(sixteens, eights, eights_a, eights_b);
+            total = _mm256_add_epi64(total, popcount(sixteens));
+        }
+
+        total = _mm256_slli_epi64(total, 4);
+        total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount(eights), 3));
+        total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount(fours), 2));
+        total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount(twos), 1));
+        total = _mm256_add_epi64(total, popcount(ones));
+
+        // the remainder of less than 64 limbs is handled by popcnt, every
+        // processor with AVX2 supports it
+        alignas(32) std::uint64_t lanes[width];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+        std::size_t result = static_cast<std::size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+        return result + count_popcnt<Xor>(l + i, Xor ? r + i : r, count - i);
+    }
+};
+#endif
+
+template<bool Xor>
+inline count_kernel select_count_kernel() noexcept
+{
+    const utility::kernel_variant<count_kernel> variants[] = {
+#if !defined(GMATHS_NO_INTRINSICS) && ((defined(_MSC_VER) && defined(_M_X64)) || (defined(__GNUC__) && defined(__x86_64__)))
+        { "avx2", utility::cpu_features{ .popcnt = true, .avx2 = true }, &avx2_isa::count<Xor> },
+        { "popcnt", utility::cpu_features{ .popcnt = true }, &count_popcnt<Xor> },
+#endif
+        { "portable", utility::cpu_features{ }, &count_portable<Xor> },
+    };
+    return utility::select_kernel("popcount", Xor ? "xor" : "", variants);
+}
+
+template<bool Xor>
+inline count_kernel runtime_count_kernel() noexcept
+{
+    static const count_kernel kernel = select_count_kernel<Xor>();
+    return kernel;
+}
+
+template<std::size_t N>
+constexpr bool use_kernel(std::size_t count) noexcept
+{
+#ifndef GMATHS_NO_INTRINSICS
+    if constexpr (N == std::dynamic_extent || N >= count_kernel_threshold) {
+        return !std::is_constant_evaluated() && count >= count_kernel_threshold;
+    }
+#endif
+    static_cast<void>(count);
+    return false;
+}
+
+/*
+ * Counts the 1 bits of the first count limbs of l, or of l ^ r.
+ */
+template<bool Xor, std::size_t N, typename LIt, typename RIt>
+constexpr std::size_t count(LIt l, RIt r, std::size_t count) noexcept
+{
+    if (use_kernel<N>(count)) {
+        if constexpr (Xor) {
+            return runtime_count_kernel<Xor>()(std::to_address(l), std::to_address(r), count);
+        } else {
+            return runtime_count_kernel<Xor>()(std::to_address(l), nullptr, count);
+        }
+    }
+
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if constexpr (Xor) {
+            total += limb_popcount(l[i] ^ r[i]);
+        } else {
+            total += limb_popcount(l[i]);
+        }
+    }
+    return total;
+}
+
+template<bool LSigned, bool RSigned, input_limb_span L, input_limb_span R>
+constexpr std::size_t hamming_distance(L l, R r) noexcept
+{
+    static_assert (std::max(L::extent, R::extent) == std::dynamic_extent || L::extent >= R::extent,
+        "expecting left range to be larger (in number of limbs) than right range");
+    assert(l.size() >= r.size());
+
+    constexpr std::size_t N = span_utils::min_extent({L::extent, R::extent});
+    std::size_t total = count<true, N>(l.begin(), r.begin(), r.size());
+
+    // beyond the shorter span the differences are those to its extension
+    limb_type rext = limb_span_sign_extension<RSigned>(r);
+    for (std::size_t i = r.size(); i < l.size(); ++i) {
+        total += limb_popcount(l[i] ^ rext);
+    }
+    return total;
+}
+
+}
+
+/**
+ * @brief Counts the 1 bits of a span.
+ *
+ * Long spans are counted by a kernel selected for the executing CPU.
+ *
+ * @param s the span whose bits shall be counted
+ * @return the number of 1 bits in @p s
+ */
+template<input_limb_span S>
+constexpr std::size_t limb_span_popcount(S s) noexcept
+{
+    return _detail_limb_span_bitcount::count<false, S::extent>(s.begin(), s.begin(), s.size());
+}
+
+/**
+ * @brief Counts the leading zeroes of a span.
+ *
+ * The scan starts at the most significant limb and stops at the first limb
+ * that is not zero.
+ *
+ * @param s the span whose leading zeroes shall be counted
+ * @return the number of 0 bits above the highest order 1 bit of @p s or
+ * `s.size() * limb_bits` if @p s is zero.
+ */
+template<input_limb_span S>
+constexpr std::size_t limb_span_countl_zero(S s) noexcept
+{
+    std::size_t n = s.size();
+    for (std::size_t i = n; i > 0; --i) {
+        if (s[i - 1] != 0) {
+            return (n - i) * limb_bits + static_cast<std::size_t>(limb_lzcount(s[i - 1]));
+        }
+    }
+    return n * limb_bits;
+}
+
+/**
+ * @brief Counts the trailing zeroes of a span.
+ *
+ * The scan starts at the least significant limb and stops at the first limb
+ * that is not zero.
+ *
+ * @param s the span whose trailing zeroes shall be counted
+ * @return the number of 0 bits below the lowest order 1 bit of @p s or
+ * `s.size() * limb_bits` if @p s is zero.
+ */
+template<input_limb_span S>
+constexpr std::size_t limb_span_countr_zero(S s) noexcept
+{
+    std::size_t n = s.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (s[i] != 0) {
+            return i * limb_bits + static_cast<std::size_t>(limb_tzcount(s[i]));
+        }
+    }
+    return n * limb_bits;
+}
+
+/**
+ * @brief Computes the number of bits needed to represent the unsigned value
+ * of a span.
+ *
+ * @param s the span
+ * @return one plus the index of the highest order 1 bit of @p s or 0 if @p s
+ * is zero
+ */
+template<input_limb_span S>
+constexpr std::size_t limb_span_bit_width(S s) noexcept
+{
+    return s.size() * limb_bits - limb_span_countl_zero(s);
+}
+
+/**
+ * @brief Counts the bits in which two spans differ.
+ *
+ * The shorter span is extended to the size of the longer one, by its sign bit
+ * if it is marked as signed and by zeroes otherwise. Long spans are compared
+ * by a kernel selected for the executing CPU.
+ *
+ * @tparam Opt tests for ::left_signed_option and ::right_signed_option, all
+ * other options are ignored
+ * @param l first span
+ * @param r second span
+ * @return the number of 1 bits in `l ^ r`
+ */
+template<limb_span_option Opt = limb_span_option(0), input_limb_span L, input_limb_span R>
+constexpr std::size_t limb_span_hamming_distance(L l, R r) noexcept
+{
+    std::span<const limb_type, L::extent> l2 = l;
+    std::span<const limb_type, R::extent> r2 = r;
+    constexpr bool LSigned = static_cast<bool>(Opt & left_signed_option);
+    constexpr bool RSigned = static_cast<bool>(Opt & right_signed_option);
+
+    if constexpr (std::max(L::extent, R::extent) == std::dynamic_extent || L::extent >= R::extent) {
+        if (l.size() >= r.size())
+            return _detail_limb_span_bitcount::hamming_distance<LSigned, RSigned>(l2, r2);
+    }
+
+    if constexpr (std::max(L::extent, R::extent) == std::dynamic_extent || L::extent < R::extent) {
+        if (l.size() < r.size())
+            return _detail_limb_span_bitcount::hamming_distance<RSigned, LSigned>(r2, l2);
+    }
+
+    // unreachable
+    return 0;
+}
+
+}
+
+#endif // !GMATHS_INTEGERS_LIMB_SPAN_BITCOUNT_HPP_INCLUDED
@@ -0,0 +1,326 @@
+#ifndef GMATHS_INTEGERS_LIMB_SPAN_BITEXPR_HPP_INCLUDED
+#define GMATHS_INTEGERS_LIMB_SPAN_BITEXPR_HPP_INCLUDED
+
+/**
+ * @file gmaths/integers/limb_span/limb_span_bitexpr.hpp
+ * @brief Provides expression templates that fuse several bitwise operations
+ * into a single pass over the limbs.
+ *
+ * Chaining the functions of limb_span_bitwise.hpp, for example to compute
+ * `(a & b) ^ ~c`, streams all limbs through memory once per operation. The
+ * expressions built here from ::limb_span_bitexpr() with the operators `&`,
+ * `|`, `^` and `~` are only evaluated by ::limb_span_biteval(), which computes
+ * every limb of the destination from the limbs of all operands at once:
+ *
+ * @code
+ * limb_span_biteval(d, (limb_span_bitexpr(a) & limb_span_bitexpr(b)) ^ ~limb_span_bitexpr(c));
+ * @endcode
+ */
+
+#include <gmaths/integers/limb_span/limb_span_base.hpp>
+#include <gmaths/integers/limb_span/limb_span_bitwise.hpp>
+
+#include <concepts>
+
+namespace gmaths::integers
+{
+
+namespace _detail_limb_span_bitexpr
+{
+
+using _detail_limb_span_bitwise::binary_unroll;
+using _detail_limb_span_bitwise::unary_unroll;
+using _detail_limb_span_bitwise::unroll_large;
+using _detail_limb_span_bitwise::unroll_small;
+
+struct expression_tag { };
+
+template<typename E>
+concept expression = std::derived_from<E, expression_tag>;
+
+/*
+ * Expressions are evaluated in blocks of this many limbs, one operation after
+ * the other through the kernels of the bitwise operations. The intermediate
+ * results of a block stay in the L1 cache.
+ */
+constexpr std::size_t block_limbs = 128;
+
+/*
+ * The limbs of an expression in a block, either in memory or all equal to
+ * value if data is null.
+ */
+struct block
+{
+    const limb_type* data;
+    limb_type value;
+};
+
+/*
+ * Every node provides
+ * - operator[](i), the limb i, provided i < min_size(),
+ * - evaluate(d, scratch, i, count), the count limbs starting at i, which are
+ *   either an operand, a constant or written to d, provided no operand ends
+ *   inside of them,
+ * - next_size(i), the least size of its operands that is greater than i,
+ * - prefetch(i, count), which requests the count limbs starting at i of its
+ *   operands,
+ * - extension(), the limbs beyond max_size(),
+ * - min_size() and max_size(), the least and greatest size of its operands,
+ * - min_extent, the least static extent of its operands,
+ * - scratch_blocks, the number of blocks evaluate() needs in scratch.
+ */
+template<bool Signed, std::size_t N>
+struct leaf : expression_tag
+{
+    static constexpr std::size_t min_extent = N;
+    static constexpr std::size_t scratch_blocks = 0;
+
+    constexpr explicit leaf(std::span<const limb_type, N> s) noexcept
+        : _span{ s }, _extension{ limb_span_sign_extension<Signed>(s) }
+    {
+    }
+
+    constexpr limb_type operator[](std::size_t i) const noexcept { return _span[i]; }
+
+    constexpr block evaluate(limb_type*, limb_type*, std::size_t i, std::size_t) const noexcept
+    {
+        return i < _span.size() ? block{ _span.data() + i, 0 } : block{ nullptr, _extension };
+    }
+
+    constexpr std::size_t next_size(std::size_t i) const noexcept { return i < _span.size() ? _span.size() : std::size_t(-1); }
+
+    void prefetch(std::size_t i, std::size_t count) const noexcept
+    {
+        for (std::size_t end = std::min(i + count, _span.size()); i < end; i += _detail_limb_span_bitwise::cache_line_limbs) {
+            _detail_limb_span_bitwise::prefetch_limb(_span.data() + i);
+        }
+    }
+
+    constexpr limb_type extension() const noexcept { return _extension; }
+    constexpr std::size_t min_size() const noexcept { return _span.size(); }
+    constexpr std::size_t max_size() const noexcept { return _span.size(); }
+
+    std::span<const limb_type, N> _span;
+    limb_type _extension;
+};
+
+template<typename Func, expression E>
+struct unary_node : expression_tag
+{
+    static constexpr std::size_t min_extent = E::min_extent;
+    static constexpr std::size_t scratch_blocks = 1 + E::scratch_blocks;
+
+    constexpr explicit unary_node(const E& e) noexcept : _e{ e } { }
+
+    constexpr limb_type operator[](std::size_t i) const noexcept { return Func{ }(_e[i]); }
+
+    constexpr block evaluate(limb_type* d, limb_type* scratch, std::size_t i, std::size_t count) const noexcept
+    {
+        block b = _e.evaluate(scratch, scratch + block_limbs, i, count);
+        if (b.data == nullptr) {
+            return block{ nullptr, Func{ }(b.value) };
+        }
+        unary_unroll<false, std::dynamic_extent>(d, b.data, Func{ }, count);
+        return block{ d, 0 };
+    }
+
+    constexpr std::size_t next_size(std::size_t i) const noexcept { return _e.next_size(i); }
+    void prefetch(std::size_t i, std::size_t count) const noexcept { _e.prefetch(i, count); }
+    constexpr limb_type extension() const noexcept { return Func{ }(_e.extension()); }
+    constexpr std::size_t min_size() const noexcept { return _e.min_size(); }
+    constexpr std::size_t max_size() const noexcept { return _e.max_size(); }
+
+    E _e;
+};
+
+template<typename Func, expression L, expression R>
+struct binary_node : expression_tag
+{
+    static constexpr std::size_t min_extent = span_utils::min_extent({L::min_extent, R::min_extent});
+    static constexpr std::size_t scratch_blocks = std::max(1 + L::scratch_blocks, 2 + R::scratch_blocks);
+
+    constexpr binary_node(const L& l, const R& r) noexcept : _l{ l }, _r{ r } { }
+
+    constexpr limb_type operator[](std::size_t i) const noexcept { return Func{ }(_l[i], _r[i]); }
+
+    /*
+     * The operands are evaluated into scratch, never into d, since d may be
+     * one of the operands of the whole expression.
+     */
+    constexpr block evaluate(limb_type* d, limb_type* scratch, std::size_t i, std::size_t count) const noexcept
+    {
+        block l = _l.evaluate(scratch, scratch + block_limbs, i, count);
+        block r = _r.evaluate(scratch + block_limbs, scratch + 2 * block_limbs, i, count);
+        if (l.data == nullptr && r.data == nullptr) {
+            return block{ nullptr, Func{ }(l.value, r.value) };
+        }
+        if (l.data == nullptr) {
+            binary_unroll<false, std::dynamic_extent>(d, r.data, l.value, typename Func::flip{ }, count);
+        } else if (r.data == nullptr) {
+            binary_unroll<false, std::dynamic_extent>(d, l.data, r.value, Func{ }, count);
+        } else {
+            binary_unroll<false, std::dynamic_extent>(d, l.data, r.data, Func{ }, count);
+        }
+        return block{ d, 0 };
+    }
+
+    constexpr std::size_t next_size(std::size_t i) const noexcept { return std::min(_l.next_size(i), _r.next_size(i)); }
+
+    void prefetch(std::size_t i, std::size_t count) const noexcept
+    {
+        _l.prefetch(i, count);
+        _r.prefetch(i, count);
+    }
+
+    constexpr limb_type extension() const noexcept { return Func{ }(_l.extension(), _r.extension()); }
+    constexpr std::size_t min_size() const noexcept { return std::min(_l.min_size(), _r.min_size()); }
+    constexpr std::size_t max_size() const noexcept { return std::max(_l.max_size(), _r.max_size()); }
+
+    L _l;
+    R _r;
+};
+
+template<expression E>
+constexpr auto operator~(const E& e) noexcept
+{
+    return unary_node<_detail_limb_span_bitwise::unary_not, E>(e);
+}
+
+template<expression L, expression R>
+constexpr auto operator&(const L& l, const R& r) noexcept
+{
+    return binary_node<_detail_limb_span_bitwise::binary_and, L, R>(l, r);
+}
+
+template<expression L, expression R>
+constexpr auto operator|(const L& l, const R& r) noexcept
+{
+    return binary_node<_detail_limb_span_bitwise::binary_or, L, R>(l, r);
+}
+
+template<expression L, expression R>
+constexpr auto operator^(const L& l, const R& r) noexcept
+{
+    return binary_node<_detail_limb_span_bitwise::binary_xor, L, R>(l, r);
+}
+
+/*
+ * Evaluates n limbs starting at i into a temporary before storing them, like
+ * the helpers of the bitwise operations, so that d may be an operand.
+ */
+template<int N, typename DIt, expression E>
+constexpr void eval_unroll_helper(DIt d, const E& e, std::size_t i, int n = N) noexcept
+{
+    limb_type arr[N]{ };
+    for (int k = 0; k < n; ++k) {
+        arr[k] = e[i + k];
+    }
+    std::copy_n(arr, n, d + i);
+}
+
+template<std::size_t N, typename DIt, expression E>
+constexpr void eval_unroll(DIt d, const E& e, std::size_t count) noexcept
+{
+    if constexpr (N != std::dynamic_extent) {
+        count = N;
+    }
+
+    std::size_t i = 0;
+    for (auto k = count / unroll_large; k > 0; --k, i += unroll_large)
+        eval_unroll_helper<unroll_large>(d, e, i);
+    for (auto k = (count % unroll_large) / unroll_small; k > 0; --k, i += unroll_small)
+        eval_unroll_helper<unroll_small>(d, e, i);
+    eval_unroll_helper<unroll_small>(d, e, i, static_cast<int>((count % unroll_large) % unroll_small));
+}
+
+/*
+ * Evaluates the limbs in [first, last) block by block. Blocks end where an
+ * operand ends, so that every operand is either read or extended as a whole.
+ * Each operation reads only some of the operands of a block, so long operands
+ * are prefetched like in the kernels to keep all of them in flight.
+ */
+template<expression E>
+constexpr void eval_blocks(limb_type* d, const E& e, std::size_t first, std::size_t last) noexcept
+{
+    limb_type scratch[std::max<std::size_t>(E::scratch_blocks, 1) * block_limbs];
+    using _detail_limb_span_bitwise::prefetch_distance;
+    bool prefetch = !std::is_constant_evaluated() && prefetch_distance != 0
+        && last - first >= _detail_limb_span_bitwise::prefetch_threshold;
+    for (std::size_t i = first; i < last;) {
+        if (prefetch) {
+            e.prefetch(i + prefetch_distance, block_limbs);
+        }
+        std::size_t count = std::min({ last - i, block_limbs, e.next_size(i) - i });
+        block b = e.evaluate(d + i, scratch, i, count);
+        if (b.data == nullptr) {
+            std::fill_n(d + i, count, b.value);
+        } else if (b.data != d + i) {
+            std::copy_n(b.data, count, d + i);
+        }
+        i += count;
+    }
+}
+
+template<output_limb_span D, expression E>
+constexpr void eval(D d, const E& e) noexcept
+{
+    constexpr std::size_t N = span_utils::min_extent({D::extent, E::min_extent});
+
+    // short operands are fused limb by limb, long ones run through the
+    // kernels block by block
+    std::size_t n = std::min(d.size(), e.min_size());
+    if (_detail_limb_span_bitwise::use_kernel<D::extent>(n)) {
+        n = 0;
+    } else {
+        eval_unroll<N>(d.begin(), e, n);
+    }
+
+    // only some operands are sign extended up to the longest one, beyond it
+    // all limbs are the same
+    std::size_t m = std::min(d.size(), e.max_size());
+    if (n < m) {
+        eval_blocks(std::to_address(d.begin()), e, n, m);
+    }
+    _detail_limb_span_bitwise::fill_limbs(d.begin() + m, d.end(), e.extension());
+}
+
+}
+
+/**
+ * @brief Wraps @p s as the operand of a bitwise expression.
+ *
+ * The expression is built with the operators `&`, `|`, `^` and `~` and
+ * evaluated by ::limb_span_biteval(). It refers to @p s, which must outlive
+ * it.
+ *
+ * @tparam Opt tests for ::arg_signed_option
+ * @param s the operand
+ */
+template<limb_span_option Opt = limb_span_option(0), input_limb_span S>
+constexpr auto limb_span_bitexpr(S s) noexcept
+{
+    constexpr bool Signed = static_cast<bool>(Opt & arg_signed_option);
+    return _detail_limb_span_bitexpr::leaf<Signed, S::extent>(std::span<const limb_type, S::extent>(s));
+}
+
+/**
+ * @brief Evaluates the bitwise expression @p e and stores the result in @p d.
+ *
+ * All operations of @p e are applied to one block of limbs after the other,
+ * so that every operand is read from memory only once. Operands shorter than
+ * @p d are extended as with the functions of
+ * limb_span_bitwise.hpp. @p d may be one of the operands of @p e as long as
+ * they start at the same limb.
+ *
+ * @param d destination of the result
+ * @param e expression built from ::limb_span_bitexpr()
+ */
+template<output_limb_span D, _detail_limb_span_bitexpr::expression E>
+constexpr void limb_span_biteval(D d, const E& e) noexcept
+{
+    _detail_limb_span_bitexpr::eval(d, e);
+}
+
+}
+
+#endif // !GMATHS_INTEGERS_LIMB_SPAN_BITEXPR_HPP_INCLUDED
@@ -2,6 +2,59 @@
 #define GMATHS_INTEGERS_LIMB_SPAN_BITWISE_HPP_INCLUDED
 
 #include <gmaths/integers/limb_span/limb_span_base.hpp>
+#include <gmaths/utility/kernel_dispatch.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if !defined(GMATHS_NO_INTRINSICS) && ((defined(_MSC_VER) && defined(_M_X64)) || (defined(__GNUC__) && defined(__x86_64__)))
+#include <immintrin.h>
+#endif
+
+/**
+ * @def GMATHS_STREAMING_STORE_THRESHOLD
+ * @brief Number of limbs of the destination from which on the bitwise
+ * operations, including the fills and copies they perform, write with
+ * non-temporal stores.
+ *
+ * Non-temporal stores bypass the caches. This keeps the working set of other
+ * code in the caches and saves reading the destination before it is
+ * overwritten, but makes writing destinations that would fit into the caches
+ * slower. The default of 2^22 limbs (32 MiB) exceeds the last level cache of
+ * most processors.
+ */
+#ifndef GMATHS_STREAMING_STORE_THRESHOLD
+#define GMATHS_STREAMING_STORE_THRESHOLD (std::size_t(1) << 22)
+#endif
+
+/**
+ * @def GMATHS_PREFETCH_DISTANCE
+ * @brief Number of limbs ahead of the current position at which the runtime
+ * kernels of the bitwise operations prefetch their operands, 0 disables
+ * software prefetching.
+ *
+ * Operations with two operands and a destination read and write three
+ * streams at once, which the hardware prefetchers of some processors do not
+ * follow far enough ahead on memory that is not cached.
+ */
+#ifndef GMATHS_PREFETCH_DISTANCE
+#define GMATHS_PREFETCH_DISTANCE 256
+#endif
+
+/**
+ * @def GMATHS_PREFETCH_THRESHOLD
+ * @brief Number of limbs from which on the runtime kernels of the bitwise
+ * operations prefetch their operands.
+ *
+ * Shorter operands are usually cached, where the prefetch instructions only
+ * take up load slots.
+ */
+#ifndef GMATHS_PREFETCH_THRESHOLD
+#define GMATHS_PREFETCH_THRESHOLD (std::size_t(1) << 15)
+#endif
 
 namespace gmaths::integers
 {
@@ -9,8 +62,6 @@ namespace gmaths::integers
 namespace _detail_limb_span_bitwise
 {
 
-std::size_t ar;
-
 struct unary_one
 {
     constexpr limb_type operator()(limb_type) const noexcept { return static_cast<limb_type>(-1); }
@@ -24,16 +75,19 @@ struct unary_zero
 struct unary_neutral
 {
     constexpr limb_type operator()(limb_type a) const noexcept { return a; }
+    static constexpr std::string_view name = "copy";
 };
 
 struct unary_not
 {
     constexpr limb_type operator()(limb_type a) const noexcept { return ~a; }
+    static constexpr std::string_view name = "not";
 };
 
 struct binary_and
 {
     constexpr limb_type operator()(limb_type l, limb_type r) const noexcept { return l & r; }
+    static constexpr std::string_view name = "and";
     using bind_one = unary_neutral;
     using bind_zero = unary_zero;
     using flip = binary_and;
@@ -42,6 +96,7 @@ struct binary_and
 struct binary_nand
 {
     constexpr limb_type operator()(limb_type l, limb_type r) const noexcept { return ~(l & r); }
+    static constexpr std::string_view name = "nand";
     using bind_one = unary_not;
     using bind_zero = unary_one;
     using flip = binary_nand;
@@ -50,6 +105,7 @@ struct binary_nand
 struct binary_or
 {
     constexpr limb_type operator()(limb_type l, limb_type r) const noexcept { return l | r; }
+    static constexpr std::string_view name = "or";
     using bind_one = unary_one;
     using bind_zero = unary_neutral;
     using flip = binary_or;
@@ -58,6 +114,7 @@ struct binary_or
 struct binary_nor
 {
     constexpr limb_type operator()(limb_type l, limb_type r) const noexcept { return ~(l | r); }
+    static constexpr std::string_view name = "nor";
     using bind_one = unary_zero;
     using bind_zero = unary_not;
     using flip = binary_nor;
@@ -66,6 +123,7 @@ struct binary_nor
 struct binary_xor
 {
     constexpr limb_type operator()(limb_type l, limb_type r) const noexcept { return l ^ r; }
+    static constexpr std::string_view name = "xor";
     using bind_one = unary_not;
     using bind_zero = unary_neutral;
     using flip = binary_xor;
@@ -74,6 +132,7 @@ struct binary_xor
 struct binary_xnor
 {
     constexpr limb_type operator()(limb_type l, limb_type r) const noexcept { return ~(l ^ r); }
+    static constexpr std::string_view name = "xnor";
     using bind_one = unary_neutral;
     using bind_zero = unary_not;
     using flip = binary_xnor;
@@ -83,6 +142,7 @@ struct binary_greater;
 struct binary_less
 {
     constexpr limb_type operator()(limb_type l, limb_type r) const noexcept { return ~l & r; }
+    static constexpr std::string_view name = "less";
     using bind_one = unary_not;
     using bind_zero = unary_zero;
     using flip = binary_greater;
@@ -91,15 +151,17 @@ struct binary_less
 struct binary_greater
 {
     constexpr limb_type operator()(limb_type l, limb_type r) const noexcept { return l & ~r; }
+    static constexpr std::string_view name = "greater";
     using bind_one = unary_zero;
     using bind_zero = unary_neutral;
-    using flip = binary_greater;
+    using flip = binary_less;
 };
 
 struct binary_geq;
 struct binary_leq
 {
     constexpr limb_type operator()(limb_type l, limb_type r) const noexcept { return ~l | r; }
+    static constexpr std::string_view name = "leq";
     using bind_one = unary_one;
     using bind_zero = unary_not;
     using flip = binary_geq;
@@ -108,11 +170,710 @@ struct binary_leq
 struct binary_geq
 {
     constexpr limb_type operator()(limb_type l, limb_type r) const noexcept { return l | ~r; }
+    static constexpr std::string_view name = "geq";
     using bind_one = unary_neutral;
     using bind_zero = unary_one;
     using flip = binary_leq;
 };
 
+/*
+ * Runtime kernels for long spans. They operate on raw pointers and are
+ * selected once according to the features of the executing CPU. Each functor
+ * is characterized by its truth table, that is its result for the operands
+ * 0xf0 and 0xcc, in the encoding of the AVX-512 `vpternlog` instruction.
+ */
+using binary_kernel = void (*)(limb_type*, const limb_type*, const limb_type*, std::size_t) noexcept;
+using broadcast_kernel = void (*)(limb_type*, const limb_type*, limb_type, std::size_t) noexcept;
+using fill_kernel = void (*)(limb_type*, limb_type, std::size_t) noexcept;
+
+/*
+ * Spans shorter than this are always handled inline. This keeps fixed size
+ * arithmetic free of indirect calls.
+ */
+constexpr std::size_t bitwise_kernel_threshold = 32;
+
+template<typename Func>
+concept binary_functor = requires { typename Func::flip; };
+
+template<typename Func>
+concept kernel_functor = binary_functor<Func> || std::is_same_v<Func, unary_not> || std::is_same_v<Func, unary_neutral>;
+
+template<kernel_functor Func>
+constexpr unsigned truth_table() noexcept
+{
+    if constexpr (binary_functor<Func>) {
+        return static_cast<unsigned>(Func{ }(0xf0, 0xcc) & 0xff);
+    } else {
+        return static_cast<unsigned>(Func{ }(0xf0) & 0xff);
+    }
+}
+
+/*
+ * Calls the functor with one or two arguments, a unary functor ignores r.
+ */
+template<kernel_functor Func>
+constexpr limb_type apply(limb_type l, limb_type r) noexcept
+{
+    if constexpr (binary_functor<Func>) {
+        return Func{ }(l, r);
+    } else {
+        static_cast<void>(r);
+        return Func{ }(l);
+    }
+}
+
+/*
+ * Kernel loops over at least prefetch_threshold limbs proceed by cache lines
+ * and request the line prefetch_distance limbs ahead of each operand before
+ * they process a line. The destination is prefetched as well unless it is
+ * written with non-temporal stores.
+ */
+constexpr std::size_t prefetch_distance = GMATHS_PREFETCH_DISTANCE;
+constexpr std::size_t prefetch_threshold = GMATHS_PREFETCH_THRESHOLD;
+constexpr std::size_t cache_line_limbs = 64 / sizeof(limb_type);
+
+inline void prefetch_limb(const limb_type* p) noexcept
+{
+#if defined(GMATHS_NO_INTRINSICS)
+    static_cast<void>(p);
+#elif defined(__GNUC__)
+    __builtin_prefetch(p);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    _mm_prefetch(reinterpret_cast<const char*>(p), _MM_HINT_T0);
+#else
+    static_cast<void>(p);
+#endif
+}
+
+template<bool Stream>
+inline void prefetch_ahead(const limb_type* d, const limb_type* l, const limb_type* r) noexcept
+{
+    prefetch_limb(l + prefetch_distance);
+    prefetch_limb(r + prefetch_distance);
+    if constexpr (!Stream) {
+        prefetch_limb(d + prefetch_distance);
+    }
+}
+
+template<bool Stream>
+inline void prefetch_ahead(const limb_type* d, const limb_type* l) noexcept
+{
+    prefetch_limb(l + prefetch_distance);
+    if constexpr (!Stream) {
+        prefetch_limb(d + prefetch_distance);
+    }
+}
+
+/*
+ * End of the prefetching part of a loop over the limbs from i up to count. It
+ * covers whole cache lines and leaves the last prefetch_distance limbs, so
+ * that no prefetch reaches beyond the operands.
+ */
+inline std::size_t prefetch_end(std::size_t i, std::size_t count) noexcept
+{
+    if (prefetch_distance == 0 || count < prefetch_threshold || count < i + prefetch_distance) {
+        return i;
+    }
+    return i + (count - prefetch_distance - i) / cache_line_limbs * cache_line_limbs;
+}
+
+template<kernel_functor Func>
+inline void binary_portable(limb_type* d, const limb_type* l, const limb_type* r, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+    for (std::size_t end = prefetch_end(i, count); i < end; i += cache_line_limbs) {
+        prefetch_ahead<false>(d + i, l + i, r + i);
+        for (std::size_t k = i; k < i + cache_line_limbs; ++k) {
+            d[k] = apply<Func>(l[k], r[k]);
+        }
+    }
+    for (; i < count; ++i) {
+        d[i] = apply<Func>(l[i], r[i]);
+    }
+}
+
+template<kernel_functor Func>
+inline void broadcast_portable(limb_type* d, const limb_type* l, limb_type r, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+    for (std::size_t end = prefetch_end(i, count); i < end; i += cache_line_limbs) {
+        prefetch_ahead<false>(d + i, l + i);
+        for (std::size_t k = i; k < i + cache_line_limbs; ++k) {
+            d[k] = apply<Func>(l[k], r);
+        }
+    }
+    for (; i < count; ++i) {
+        d[i] = apply<Func>(l[i], r);
+    }
+}
+
+inline void fill_portable(limb_type* d, limb_type v, std::size_t count) noexcept
+{
+    std::fill_n(d, count, v);
+}
+
+#if !defined(GMATHS_NO_INTRINSICS) && ((defined(_MSC_VER) && defined(_M_X64)) || (defined(__GNUC__) && defined(__x86_64__)))
+/*
+ * SSE2 and AVX2 lack a generic logic instruction, so each truth table is
+ * decomposed into one of and, or, xor, andnot (`~a & b`) or the identity of
+ * the first operand, with optionally swapped operands and a negated result.
+ */
+enum class logic_op
+{
+    and_op,
+    or_op,
+    xor_op,
+    andnot_op,
+    first_op
+};
+
+struct logic_form
+{
+    logic_op op;
+    bool swap;
+    bool negate;
+};
+
+constexpr logic_form decompose(unsigned table) noexcept
+{
+    switch (table) {
+    case 0xc0: return { logic_op::and_op, false, false };
+    case 0x3f: return { logic_op::and_op, false, true };
+    case 0xfc: return { logic_op::or_op, false, false };
+    case 0x03: return { logic_op::or_op, false, true };
+    case 0x3c: return { logic_op::xor_op, false, false };
+    case 0xc3: return { logic_op::xor_op, false, true };
+    case 0x0c: return { logic_op::andnot_op, false, false };
+    case 0xf3: return { logic_op::andnot_op, false, true };
+    case 0x30: return { logic_op::andnot_op, true, false };
+    case 0xcf: return { logic_op::andnot_op, true, true };
+    case 0xf0: return { logic_op::first_op, false, false };
+    case 0x0f:
+    default: return { logic_op::first_op, false, true };
+    }
+}
+
+/*
+ * Non-temporal stores write around the caches and require aligned vectors.
+ * The limbs up to the first aligned address of the destination and the
+ * remaining limbs are stored one at a time with movnti, and a final sfence
+ * orders all of them before later stores.
+ */
+inline void stream_limb(limb_type* p, limb_type v) noexcept
+{
+#ifdef _MSC_VER
+    _mm_stream_si64x(reinterpret_cast<long long*>(p), static_cast<long long>(v));
+#else
+    _mm_stream_si64(reinterpret_cast<long long*>(p), static_cast<long long>(v));
+#endif
+}
+
+/*
+ * Number of limbs in front of the first address of d that is aligned to
+ * Bytes, at most count.
+ */
+template<std::size_t Bytes>
+inline std::size_t stream_head(const limb_type* d, std::size_t count) noexcept
+{
+    constexpr std::size_t limbs = Bytes / sizeof(limb_type);
+    std::size_t misaligned = (reinterpret_cast<std::uintptr_t>(d) / sizeof(limb_type)) % limbs;
+    return std::min(count, misaligned == 0 ? 0 : limbs - misaligned);
+}
+
+template<typename Func>
+inline void stream_limbs(limb_type* d, std::size_t first, std::size_t last, Func f) noexcept
+{
+    for (; first < last; ++first) {
+        stream_limb(d + first, f(first));
+    }
+}
+
+struct sse2_isa
+{
+    static constexpr std::size_t width = 2;
+
+    template<unsigned Table>
+    static __m128i logic(__m128i a, __m128i b) noexcept
+    {
+        constexpr logic_form form = decompose(Table);
+        if constexpr (form.swap) {
+            __m128i t = a;
+            a = b;
+            b = t;
+        }
+        __m128i x;
+        if constexpr (form.op == logic_op::and_op) {
+            x = _mm_and_si128(a, b);
+        } else if constexpr (form.op == logic_op::or_op) {
+            x = _mm_or_si128(a, b);
+        } else if constexpr (form.op == logic_op::xor_op) {
+            x = _mm_xor_si128(a, b);
+        } else if constexpr (form.op == logic_op::andnot_op) {
+            x = _mm_andnot_si128(a, b);
+        } else {
+            x = a;
+        }
+        if constexpr (form.negate) {
+            x = _mm_xor_si128(x, _mm_set1_epi32(-1));
+        }
+        return x;
+    }
+
+    template<bool Stream>
+    static void store(limb_type* p, __m128i v) noexcept
+    {
+        if constexpr (Stream) {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(p), v);
+        } else {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+        }
+    }
+
+    template<kernel_functor Func, bool Stream>
+    static void binary_step(limb_type* d, const limb_type* l, const limb_type* r) noexcept
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r));
+        store<Stream>(d, logic<truth_table<Func>()>(a, b));
+    }
+
+    template<kernel_functor Func, bool Stream>
+    static void broadcast_step(limb_type* d, const limb_type* l, __m128i b) noexcept
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l));
+        store<Stream>(d, logic<truth_table<Func>()>(a, b));
+    }
+
+    template<kernel_functor Func, bool Stream>
+    static void binary(limb_type* d, const limb_type* l, const limb_type* r, std::size_t count) noexcept
+    {
+        auto scalar = [=](std::size_t k) { return apply<Func>(l[k], r[k]); };
+        std::size_t i = 0;
+        if constexpr (Stream) {
+            i = stream_head<sizeof(__m128i)>(d, count);
+            stream_limbs(d, 0, i, scalar);
+        }
+        for (std::size_t end = prefetch_end(i, count); i < end; i += cache_line_limbs) {
+            prefetch_ahead<Stream>(d + i, l + i, r + i);
+            for (std::size_t k = i; k < i + cache_line_limbs; k += width) {
+                binary_step<Func, Stream>(d + k, l + k, r + k);
+            }
+        }
+        for (; i + width <= count; i += width) {
+            binary_step<Func, Stream>(d + i, l + i, r + i);
+        }
+        if constexpr (Stream) {
+            stream_limbs(d, i, count, scalar);
+            _mm_sfence();
+        } else {
+            binary_portable<Func>(d + i, l + i, r + i, count - i);
+        }
+    }
+
+    template<kernel_functor Func, bool Stream>
+    static void broadcast(limb_type* d, const limb_type* l, limb_type r, std::size_t count) noexcept
+    {
+        auto scalar = [=](std::size_t k) { return apply<Func>(l[k], r); };
+        __m128i b = _mm_set1_epi64x(static_cast<long long>(r));
+        std::size_t i = 0;
+        if constexpr (Stream) {
+            i = stream_head<sizeof(__m128i)>(d, count);
+            stream_limbs(d, 0, i, scalar);
+        }
+        for (std::size_t end = prefetch_end(i, count); i < end; i += cache_line_limbs) {
+            prefetch_ahead<Stream>(d + i, l + i);
+            for (std::size_t k = i; k < i + cache_line_limbs; k += width) {
+                broadcast_step<Func, Stream>(d + k, l + k, b);
+            }
+        }
+        for (; i + width <= count; i += width) {
+            broadcast_step<Func, Stream>(d + i, l + i, b);
+        }
+        if constexpr (Stream) {
+            stream_limbs(d, i, count, scalar);
+            _mm_sfence();
+        } else {
+            broadcast_portable<Func>(d + i, l + i, r, count - i);
+        }
+    }
+
+    static void stream_fill(limb_type* d, limb_type v, std::size_t count) noexcept
+    {
+        auto scalar = [=](std::size_t) { return v; };
+        __m128i x = _mm_set1_epi64x(static_cast<long long>(v));
+        std::size_t i = stream_head<sizeof(__m128i)>(d, count);
+        stream_limbs(d, 0, i, scalar);
+        for (; i + width <= count; i += width) {
+            store<true>(d + i, x);
+        }
+        stream_limbs(d, i, count, scalar);
+        _mm_sfence();
+    }
+};
+
+struct avx2_isa
+{
+    static constexpr std::size_t width = 4;
+
+    template<unsigned Table>
+    GMATHS_TARGET_AVX2 static __m256i logic(__m256i a, __m256i b) noexcept
+    {
+        constexpr logic_form form = decompose(Table);
+        if constexpr (form.swap) {
+            __m256i t = a;
+            a = b;
+            b = t;
+        }
+        __m256i x;
+        if constexpr (form.op == logic_op::and_op) {
+            x = _mm256_and_si256(a, b);
+        } else if constexpr (form.op == logic_op::or_op) {
+            x = _mm256_or_si256(a, b);
+        } else if constexpr (form.op == logic_op::xor_op) {
+            x = _mm256_xor_si256(a, b);
+        } else if constexpr (form.op == logic_op::andnot_op) {
+            x = _mm256_andnot_si256(a, b);
+        } else {
+            x = a;
+        }
+        if constexpr (form.negate) {
+            x = _mm256_xor_si256(x, _mm256_set1_epi32(-1));
+        }
+        return x;
+    }
+
+    template<bool Stream>
+    GMATHS_TARGET_AVX2 static void store(limb_type* p, __m256i v) noexcept
+    {
+        if constexpr (Stream) {
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(p), v);
+        } else {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+        }
+    }
+
+    template<kernel_functor Func, bool Stream>
+    GMATHS_TARGET_AVX2 static void binary_step(limb_type* d, const limb_type* l, const limb_type* r) noexcept
+    {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r));
+        store<Stream>(d, logic<truth_table<Func>()>(a, b));
+    }
+
+    template<kernel_functor Func, bool Stream>
+    GMATHS_TARGET_AVX2 static void broadcast_step(limb_type* d, const limb_type* l, __m256i b) noexcept
+    {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l));
+        store<Stream>(d, logic<truth_table<Func>()>(a, b));
+    }
+
+    template<kernel_functor Func, bool Stream>
+    GMATHS_TARGET_AVX2 static void binary(limb_type* d, const limb_type* l, const limb_type* r, std::size_t count) noexcept
+    {
+        auto scalar = [=](std::size_t k) { return apply<Func>(l[k], r[k]); };
+        std::size_t i = 0;
+        if constexpr (Stream) {
+            i = stream_head<sizeof(__m256i)>(d, count);
+            stream_limbs(d, 0, i, scalar);
+        }
+        for (std::size_t end = prefetch_end(i, count); i < end; i += cache_line_limbs) {
+            prefetch_ahead<Stream>(d + i, l + i, r + i);
+            for (std::size_t k = i; k < i + cache_line_limbs; k += width) {
+                binary_step<Func, Stream>(d + k, l + k, r + k);
+            }
+        }
+        for (; i + width <= count; i += width) {
+            binary_step<Func, Stream>(d + i, l + i, r + i);
+        }
+        if constexpr (Stream) {
+            stream_limbs(d, i, count, scalar);
+            _mm_sfence();
+        } else {
+            binary_portable<Func>(d + i, l + i, r + i, count - i);
+        }
+    }
+
+    template<kernel_functor Func, bool Stream>
+    GMATHS_TARGET_AVX2 static void broadcast(limb_type* d, const limb_type* l, limb_type r, std::size_t count) noexcept
+    {
+        auto scalar = [=](std::size_t k) { return apply<Func>(l[k], r); };
+        __m256i b = _mm256_set1_epi64x(static_cast<long long>(r));
+        std::size_t i = 0;
+        if constexpr (Stream) {
+            i = stream_head<sizeof(__m256i)>(d, count);
+            stream_limbs(d, 0, i, scalar);
+        }
+        for (std::size_t end = prefetch_end(i, count); i < end; i += cache_line_limbs) {
+            prefetch_ahead<Stream>(d + i, l + i);
+            for (std::size_t k = i; k < i + cache_line_limbs; k += width) {
+                broadcast_step<Func, Stream>(d + k, l + k, b);
+            }
+        }
+        for (; i + width <= count; i += width) {
+            broadcast_step<Func, Stream>(d + i, l + i, b);
+        }
+        if constexpr (Stream) {
+            stream_limbs(d, i, count, scalar);
+            _mm_sfence();
+        } else {
+            broadcast_portable<Func>(d + i, l + i, r, count - i);
+        }
+    }
+
+    GMATHS_TARGET_AVX2 static void stream_fill(limb_type* d, limb_type v, std::size_t count) noexcept
+    {
+        auto scalar = [=](std::size_t) { return v; };
+        __m256i x = _mm256_set1_epi64x(static_cast<long long>(v));
+        std::size_t i = stream_head<sizeof(__m256i)>(d, count);
+        stream_limbs(d, 0, i, scalar);
+        for (; i + width <= count; i += width) {
+            store<true>(d + i, x);
+        }
+        stream_limbs(d, i, count, scalar);
+        _mm_sfence();
+    }
+};
+
+/*
+ * `vpternlog` evaluates any truth table in one instruction. The remaining
+ * limbs are handled with masked loads and stores.
+ */
+struct avx512_isa
+{
+    static constexpr std::size_t width = 8;
+
+    /*
+     * The table is a template argument so that it is an immediate without
+     * optimization as well.
+     */
+    template<unsigned Table>
+    GMATHS_TARGET_AVX512 static __m512i logic(__m512i a, __m512i b) noexcept
+    {
+        return _mm512_ternarylogic_epi64(a, b, b, Table);
+    }
+
+    template<bool Stream>
+    GMATHS_TARGET_AVX512 static void store(limb_type* p, __m512i v) noexcept
+    {
+        if constexpr (Stream) {
+            _mm512_stream_si512(reinterpret_cast<__m512i*>(p), v);
+        } else {
+            _mm512_storeu_si512(p, v);
+        }
+    }
+
+    template<kernel_functor Func, bool Stream>
+    GMATHS_TARGET_AVX512 static void binary_step(limb_type* d, const limb_type* l, const limb_type* r) noexcept
+    {
+        __m512i a = _mm512_loadu_si512(l);
+        __m512i b = _mm512_loadu_si512(r);
+        store<Stream>(d, logic<truth_table<Func>()>(a, b));
+    }
+
+    template<kernel_functor Func, bool Stream>
+    GMATHS_TARGET_AVX512 static void broadcast_step(limb_type* d, const limb_type* l, __m512i b) noexcept
+    {
+        __m512i a = _mm512_loadu_si512(l);
+        store<Stream>(d, logic<truth_table<Func>()>(a, b));
+    }
+
+    template<kernel_functor Func, bool Stream>
+    GMATHS_TARGET_AVX512 static void binary(limb_type* d, const limb_type* l, const limb_type* r, std::size_t count) noexcept
+    {
+        auto scalar = [=](std::size_t k) { return apply<Func>(l[k], r[k]); };
+        std::size_t i = 0;
+        if constexpr (Stream) {
+            i = stream_head<sizeof(__m512i)>(d, count);
+            stream_limbs(d, 0, i, scalar);
+        }
+        for (std::size_t end = prefetch_end(i, count); i < end; i += cache_line_limbs) {
+            prefetch_ahead<Stream>(d + i, l + i, r + i);
+            for (std::size_t k = i; k < i + cache_line_limbs; k += width) {
+                binary_step<Func, Stream>(d + k, l + k, r + k);
+            }
+        }
+        for (; i + width <= count; i += width) {
+            binary_step<Func, Stream>(d + i, l + i, r + i);
+        }
+        if constexpr (Stream) {
+            stream_limbs(d, i, count, scalar);
+            _mm_sfence();
+        } else if (i < count) {
+            __mmask8 m = static_cast<__mmask8>((1u << (count - i)) - 1);
+            __m512i a = _mm512_maskz_loadu_epi64(m, l + i);
+            __m512i b = _mm512_maskz_loadu_epi64(m, r + i);
+            _mm512_mask_storeu_epi64(d + i, m, logic<truth_table<Func>()>(a, b));
+        }
+    }
+
+    template<kernel_functor Func, bool Stream>
+    GMATHS_TARGET_AVX512 static void broadcast(limb_type* d, const limb_type* l, limb_type r, std::size_t count) noexcept
+    {
+        auto scalar = [=](std::size_t k) { return apply<Func>(l[k], r); };
+        __m512i b = _mm512_set1_epi64(static_cast<long long>(r));
+        std::size_t i = 0;
+        if constexpr (Stream) {
+            i = stream_head<sizeof(__m512i)>(d, count);
+            stream_limbs(d, 0, i, scalar);
+        }
+        for (std::size_t end = prefetch_end(i, count); i < end; i += cache_line_limbs) {
+            prefetch_ahead<Stream>(d + i, l + i);
+            for (std::size_t k = i; k < i + cache_line_limbs; k += width) {
+                broadcast_step<Func, Stream>(d + k, l + k, b);
+            }
+        }
+        for (; i + width <= count; i += width) {
+            broadcast_step<Func, Stream>(d + i, l + i, b);
+        }
+        if constexpr (Stream) {
+            stream_limbs(d, i, count, scalar);
+            _mm_sfence();
+        } else if (i < count) {
+            __mmask8 m = static_cast<__mmask8>((1u << (count - i)) - 1);
+            __m512i a = _mm512_maskz_loadu_epi64(m, l + i);
+            _mm512_mask_storeu_epi64(d + i, m, logic<truth_table<Func>()>(a, b));
+        }
+    }
+
+    GMATHS_TARGET_AVX512 static void stream_fill(limb_type* d, limb_type v, std::size_t count) noexcept
+    {
+        auto scalar = [=](std::size_t) { return v; };
+        __m512i x = _mm512_set1_epi64(static_cast<long long>(v));
+        std::size_t i = stream_head<sizeof(__m512i)>(d, count);
+        stream_limbs(d, 0, i, scalar);
+        for (; i + width <= count; i += width) {
+            store<true>(d + i, x);
+        }
+        stream_limbs(d, i, count, scalar);
+        _mm_sfence();
+    }
+};
+#endif
+
+template<kernel_functor Func, bool Stream>
+inline binary_kernel select_binary_kernel() noexcept
+{
+    const utility::kernel_variant<binary_kernel> variants[] = {
+#if !defined(GMATHS_NO_INTRINSICS) && ((defined(_MSC_VER) && defined(_M_X64)) || (defined(__GNUC__) && defined(__x86_64__)))
+        { "avx512", utility::cpu_features{ .avx512f = true }, &avx512_isa::binary<Func, Stream> },
+        { "avx2", utility::cpu_features{ .avx2 = true }, &avx2_isa::binary<Func, Stream> },
+        { "sse2", utility::cpu_features{ .sse2 = true }, &sse2_isa::binary<Func, Stream> },
+#endif
+        { "portable", utility::cpu_features{ }, &binary_portable<Func> },
+    };
+    return utility::select_kernel(Stream ? "bitwise_binary_stream" : "bitwise_binary", Func::name, variants);
+}
+
+template<kernel_functor Func, bool Stream>
+inline broadcast_kernel select_broadcast_kernel() noexcept
+{
+    const utility::kernel_variant<broadcast_kernel> variants[] = {
+#if !defined(GMATHS_NO_INTRINSICS) && ((defined(_MSC_VER) && defined(_M_X64)) || (defined(__GNUC__) && defined(__x86_64__)))
+        { "avx512", utility::cpu_features{ .avx512f = true }, &avx512_isa::broadcast<Func, Stream> },
+        { "avx2", utility::cpu_features{ .avx2 = true }, &avx2_isa::broadcast<Func, Stream> },
+        { "sse2", utility::cpu_features{ .sse2 = true }, &sse2_isa::broadcast<Func, Stream> },
+#endif
+        { "portable", utility::cpu_features{ }, &broadcast_portable<Func> },
+    };
+    return utility::select_kernel(Stream ? "bitwise_broadcast_stream" : "bitwise_broadcast", Func::name, variants);
+}
+
+inline fill_kernel select_stream_fill_kernel() noexcept
+{
+    const utility::kernel_variant<fill_kernel> variants[] = {
+#if !defined(GMATHS_NO_INTRINSICS) && ((defined(_MSC_VER) && defined(_M_X64)) || (defined(__GNUC__) && defined(__x86_64__)))
+        { "avx512", utility::cpu_features{ .avx512f = true }, &avx512_isa::stream_fill },
+        { "avx2", utility::cpu_features{ .avx2 = true }, &avx2_isa::stream_fill },
+        { "sse2", utility::cpu_features{ .sse2 = true }, &sse2_isa::stream_fill },
+#endif
+        { "portable", utility::cpu_features{ }, &fill_portable },
+    };
+    return utility::select_kernel("bitwise_fill_stream", "", variants);
+}
+
+template<kernel_functor Func, bool Stream>
+inline binary_kernel runtime_binary_kernel() noexcept
+{
+    static const binary_kernel kernel = select_binary_kernel<Func, Stream>();
+    return kernel;
+}
+
+template<kernel_functor Func, bool Stream>
+inline broadcast_kernel runtime_broadcast_kernel() noexcept
+{
+    static const broadcast_kernel kernel = select_broadcast_kernel<Func, Stream>();
+    return kernel;
+}
+
+inline fill_kernel runtime_stream_fill_kernel() noexcept
+{
+    static const fill_kernel kernel = select_stream_fill_kernel();
+    return kernel;
+}
+
+/*
+ * Destinations of at least this many limbs are written with non-temporal
+ * stores.
+ */
+constexpr std::size_t streaming_store_threshold = GMATHS_STREAMING_STORE_THRESHOLD;
+
+template<kernel_functor Func>
+inline binary_kernel runtime_binary_kernel(std::size_t count) noexcept
+{
+    return count >= streaming_store_threshold ? runtime_binary_kernel<Func, true>() : runtime_binary_kernel<Func, false>();
+}
+
+template<kernel_functor Func>
+inline broadcast_kernel runtime_broadcast_kernel(std::size_t count) noexcept
+{
+    return count >= streaming_store_threshold ? runtime_broadcast_kernel<Func, true>() : runtime_broadcast_kernel<Func, false>();
+}
+
+/*
+ * Tests if a loop of count limbs with a static extent N is handed to a runtime
+ * kernel, provided the functor has one.
+ */
+template<std::size_t N>
+constexpr bool use_kernel(std::size_t count) noexcept
+{
+#ifndef GMATHS_NO_INTRINSICS
+    if constexpr (N == std::dynamic_extent || N >= bitwise_kernel_threshold) {
+        return !std::is_constant_evaluated() && count >= bitwise_kernel_threshold;
+    }
+#endif
+    static_cast<void>(count);
+    return false;
+}
+
+/*
+ * Fills and copies of destinations of at least ::streaming_store_threshold
+ * limbs use non-temporal stores.
+ */
+template<typename DIt>
+constexpr void fill_limbs(DIt first, DIt last, limb_type v) noexcept
+{
+#ifndef GMATHS_NO_INTRINSICS
+    std::size_t count = static_cast<std::size_t>(last - first);
+    if (!std::is_constant_evaluated() && count >= streaming_store_threshold) {
+        runtime_stream_fill_kernel()(std::to_address(first), v, count);
+        return;
+    }
+#endif
+    std::fill(first, last, v);
+}
+
+template<typename RIt, typename DIt>
+constexpr void copy_limbs(RIt r, std::size_t count, DIt d) noexcept
+{
+#ifndef GMATHS_NO_INTRINSICS
+    if (!std::is_constant_evaluated() && count >= streaming_store_threshold) {
+        runtime_broadcast_kernel<unary_neutral, true>()(std::to_address(d), std::to_address(r), 0, count);
+        return;
+    }
+#endif
+    std::copy_n(r, count, d);
+}
+
 template<int N, typename DIt, typename RIt, typename Func>
 constexpr void unary_unroll_helper(DIt d, RIt r, Func f, int n = N) noexcept
 {
@@ -151,6 +912,60 @@ constexpr void binary_unroll_helper(DIt d, LIt l, limb_type r, Func f, int n = N
 constexpr int unroll_large = 16;
 constexpr int unroll_small = 4;
 
+/*
+ * Loops for a destination that does not overlap with the operands, or that
+ * is the only operand. They access the limbs directly instead of copying them
+ * through the arrays of the unroll helpers, which lets the compiler keep them
+ * in registers and vectorize the loop.
+ */
+template<typename Func>
+constexpr void unary_stream(limb_type* d, Func f, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        d[i] = f(d[i]);
+    }
+}
+
+template<typename Func>
+constexpr void unary_restrict(limb_type* GMATHS_RESTRICT d, const limb_type* GMATHS_RESTRICT r, Func f, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        d[i] = f(r[i]);
+    }
+}
+
+template<typename Func>
+constexpr void binary_stream(limb_type* d, limb_type r, Func f, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        d[i] = f(d[i], r);
+    }
+}
+
+template<typename Func>
+constexpr void binary_restrict(limb_type* GMATHS_RESTRICT d, const limb_type* GMATHS_RESTRICT l, limb_type r, Func f, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        d[i] = f(l[i], r);
+    }
+}
+
+template<typename Func>
+constexpr void binary_inplace_restrict(limb_type* GMATHS_RESTRICT d, const limb_type* GMATHS_RESTRICT r, Func f, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        d[i] = f(d[i], r[i]);
+    }
+}
+
+template<typename Func>
+constexpr void binary_restrict(limb_type* GMATHS_RESTRICT d, const limb_type* GMATHS_RESTRICT l, const limb_type* GMATHS_RESTRICT r, Func f, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        d[i] = f(l[i], r[i]);
+    }
+}
+
 template<std::size_t N, typename DIt, typename Func>
 constexpr void unary_inplace_unroll(DIt d, Func f, std::size_t count) noexcept
 {
@@ -158,20 +973,35 @@ constexpr void unary_inplace_unroll(DIt d, Func f, std::size_t count) noexcept
         count = N;
     }
 
-    for (auto i = count / unroll_large; i > 0; --i, d += unroll_large)
-        unary_unroll_helper<unroll_large>(d, d, f);
-    for (auto i = (count % unroll_large) / unroll_small; i > 0; --i, d += unroll_small)
-        unary_unroll_helper<unroll_small>(d, d, f);
-    unary_unroll_helper<unroll_small>(d, d, f, (count % unroll_large) % unroll_small);
+    if constexpr (kernel_functor<Func>) {
+        if (use_kernel<N>(count)) {
+            runtime_broadcast_kernel<Func>(count)(std::to_address(d), std::to_address(d), 0, count);
+            return;
+        }
+    }
+
+    unary_stream(std::to_address(d), f, count);
 }
 
-template<std::size_t N, typename DIt, typename RIt, typename Func>
+template<bool Restrict, std::size_t N, typename DIt, typename RIt, typename Func>
 constexpr void unary_unroll(DIt d, RIt r, Func f, std::size_t count) noexcept
 {
     if constexpr (N != std::dynamic_extent) {
         count = N;
     }
 
+    if constexpr (kernel_functor<Func>) {
+        if (use_kernel<N>(count)) {
+            runtime_broadcast_kernel<Func>(count)(std::to_address(d), std::to_address(r), 0, count);
+            return;
+        }
+    }
+
+    if constexpr (Restrict) {
+        unary_restrict(std::to_address(d), std::to_address(r), f, count);
+        return;
+    }
+
     for (auto i = count / unroll_large; i > 0; --i, d += unroll_large, r += unroll_large)
         unary_unroll_helper<unroll_large>(d, r, f);
     for (auto i = (count % unroll_large) / unroll_small; i > 0; --i, d += unroll_small, r += unroll_small)
@@ -186,20 +1016,35 @@ constexpr void binary_inplace_unroll(DIt d, limb_type r, Func f, std::size_t cou
         count = N;
     }
 
-    for (auto i = count / unroll_large; i > 0; --i, d += unroll_large)
-        binary_unroll_helper<unroll_large>(d, d, r, f);
-    for (auto i = (count % unroll_large) / unroll_small; i > 0; --i, d += unroll_small)
-        binary_unroll_helper<unroll_small>(d, d, r, f);
-    binary_unroll_helper<unroll_small>(d, d, r, f, (count % unroll_large) % unroll_small);
+    if constexpr (kernel_functor<Func>) {
+        if (use_kernel<N>(count)) {
+            runtime_broadcast_kernel<Func>(count)(std::to_address(d), std::to_address(d), r, count);
+            return;
+        }
+    }
+
+    binary_stream(std::to_address(d), r, f, count);
 }
 
-template<std::size_t N, typename DIt, typename LIt, typename Func>
+template<bool Restrict, std::size_t N, typename DIt, typename LIt, typename Func>
 constexpr void binary_unroll(DIt d, LIt l, limb_type r, Func f, std::size_t count) noexcept
 {
     if constexpr (N != std::dynamic_extent) {
         count = N;
     }
 
+    if constexpr (kernel_functor<Func>) {
+        if (use_kernel<N>(count)) {
+            runtime_broadcast_kernel<Func>(count)(std::to_address(d), std::to_address(l), r, count);
+            return;
+        }
+    }
+
+    if constexpr (Restrict) {
+        binary_restrict(std::to_address(d), std::to_address(l), r, f, count);
+        return;
+    }
+
     for (auto i = count / unroll_large; i > 0; --i, d += unroll_large, l += unroll_large)
         binary_unroll_helper<unroll_large>(d, l, r, f);
     for (auto i = (count % unroll_large) / unroll_small; i > 0; --i, d += unroll_small, l += unroll_small)
@@ -207,13 +1052,25 @@ constexpr void binary_unroll(DIt d, LIt l, limb_type r, Func f, std::size_t coun
     binary_unroll_helper<unroll_small>(d, l, r, f, (count % unroll_large) % unroll_small);
 }
 
-template<std::size_t N, typename DIt, typename RIt, typename Func>
+template<bool Restrict, std::size_t N, typename DIt, typename RIt, typename Func>
 constexpr void binary_inplace_unroll(DIt d, RIt r, Func f, std::size_t count) noexcept
 {
     if constexpr (N != std::dynamic_extent) {
         count = N;
     }
 
+    if constexpr (kernel_functor<Func>) {
+        if (use_kernel<N>(count)) {
+            runtime_binary_kernel<Func>(count)(std::to_address(d), std::to_address(d), std::to_address(r), count);
+            return;
+        }
+    }
+
+    if constexpr (Restrict) {
+        binary_inplace_restrict(std::to_address(d), std::to_address(r), f, count);
+        return;
+    }
+
     for (auto i = count / unroll_large; i > 0; --i, d += unroll_large, r += unroll_large)
         binary_unroll_helper<unroll_large>(d, d, r, f);
     for (auto i = (count % unroll_large) / unroll_small; i > 0; --i, d += unroll_small, r += unroll_small)
@@ -221,13 +1078,25 @@ constexpr void binary_inplace_unroll(DIt d, RIt r, Func f, std::size_t count) no
     binary_unroll_helper<unroll_small>(d, d, r, f, (count % unroll_large) % unroll_small);
 }
 
-template<std::size_t N, typename DIt, typename LIt, typename RIt, typename Func>
+template<bool Restrict, std::size_t N, typename DIt, typename LIt, typename RIt, typename Func>
 constexpr void binary_unroll(DIt d, LIt l, RIt r, Func f, std::size_t count) noexcept
 {
     if constexpr (N != std::dynamic_extent) {
         count = N;
     }
 
+    if constexpr (kernel_functor<Func>) {
+        if (use_kernel<N>(count)) {
+            runtime_binary_kernel<Func>(count)(std::to_address(d), std::to_address(l), std::to_address(r), count);
+            return;
+        }
+    }
+
+    if constexpr (Restrict) {
+        binary_restrict(std::to_address(d), std::to_address(l), std::to_address(r), f, count);
+        return;
+    }
+
     for (auto i = count / unroll_large; i > 0; --i, d += unroll_large, l += unroll_large, r += unroll_large)
         binary_unroll_helper<unroll_large>(d, l, r, f);
     for (auto i = (count % unroll_large) / unroll_small; i > 0; --i, d += unroll_small, l += unroll_small, r += unroll_small)
@@ -239,7 +1108,7 @@ template<output_limb_span D, typename Func>
 constexpr void unary_inplace(D d, Func f) noexcept
 {
     if constexpr (std::is_same_v<Func, unary_one> || std::is_same_v<Func, unary_zero>) {
-        std::fill(d.begin(), d.end(), f(0));
+        fill_limbs(d.begin(), d.end(), f(0));
     } else if constexpr (std::is_same_v<Func, unary_neutral>) {
         return;
     } else {
@@ -247,26 +1116,31 @@ constexpr void unary_inplace(D d, Func f) noexcept
     }
 }
 
-template<bool RSigned, output_limb_span D, input_limb_span R, typename Func>
+template<bool Restrict, bool RSigned, output_limb_span D, input_limb_span R, typename Func>
 constexpr void unary(D d, R r, Func f) noexcept
 {
     constexpr std::size_t DN = D::extent;
     constexpr std::size_t RN = R::extent;
 
     if constexpr (std::is_same_v<Func, unary_one> || std::is_same_v<Func, unary_zero>) {
-        std::fill(d.begin(), d.end(), f(0));
+        fill_limbs(d.begin(), d.end(), f(0));
     } else if constexpr (std::is_same_v<Func, unary_neutral>) {
-        std::copy_n(r.begin(), std::min(d.size(), r.size()), d.begin());
+        limb_type rext = limb_span_sign_extension<RSigned>(r);
+        std::size_t n = std::min(d.size(), r.size());
+        copy_limbs(r.begin(), n, d.begin());
+        fill_limbs(d.begin() + n, d.end(), rext);
     } else {
+        // d may begin at r, so the extension is read before d is written
+        limb_type rext = limb_span_sign_extension<RSigned>(r);
         constexpr std::size_t N = span_utils::min_extent({DN, RN});
-        unary_unroll<N>(d.begin(), r.begin(), f, std::min(d.size(), r.size()));
+        unary_unroll<Restrict, N>(d.begin(), r.begin(), f, std::min(d.size(), r.size()));
 
         if constexpr (std::max(DN, RN) == std::dynamic_extent || DN > RN) {
             if (d.size() <= r.size()) {
                 return;
             }
 
-            std::fill(d.begin() + r.size(), d.end(), f(limb_span_sign_extension<RSigned>(r)));
+            fill_limbs(d.begin() + r.size(), d.end(), f(rext));
         }
     }
 }
@@ -287,54 +1161,58 @@ constexpr void binary_inplace(D d, limb_type r, Func f) noexcept
     }
 }
 
-template<bool Branchless, bool LSigned, bool RSigned, output_limb_span D, input_limb_span L, typename Func>
+template<bool Restrict, bool Branchless, bool LSigned, bool RSigned, output_limb_span D, input_limb_span L, typename Func>
 constexpr void binary(D d, L l, limb_type r, Func f) noexcept
 {
     constexpr std::size_t DN = D::extent;
     constexpr std::size_t LN = L::extent;
 
     if constexpr (!RSigned) {
-        unary<LSigned>(d, l, typename Func::bind_zero{ });
+        unary<Restrict, LSigned>(d, l, typename Func::bind_zero{ });
     } else if constexpr (!Branchless) {
         if (r) {
-            unary<LSigned>(d, l, typename Func::bind_one{ });
+            unary<Restrict, LSigned>(d, l, typename Func::bind_one{ });
         } else {
-            unary<LSigned>(d, l, typename Func::bind_zero{ });
+            unary<Restrict, LSigned>(d, l, typename Func::bind_zero{ });
         }
     } else {
+        // d may begin at l, so the extension is read before d is written
+        limb_type lext = limb_span_sign_extension<LSigned>(l);
         constexpr std::size_t N = span_utils::min_extent({DN, LN});
-        binary_unroll<N>(d.begin(), l.begin(), r, f, std::min(d.size(), l.size()));
+        binary_unroll<Restrict, N>(d.begin(), l.begin(), r, f, std::min(d.size(), l.size()));
 
         if constexpr (std::max(DN, LN) == std::dynamic_extent || DN > LN) {
             if (d.size() <= l.size()) {
                 return;
             }
 
-            std::fill(d.begin() + l.size(), d.end(), f(limb_span_sign_extension<LSigned>(l), r));
+            fill_limbs(d.begin() + l.size(), d.end(), f(lext, r));
         }
     }
 }
 
 
-template<bool Branchless, bool RSigned, output_limb_span D, input_limb_span R, typename Func>
+template<bool Restrict, bool Branchless, bool RSigned, output_limb_span D, input_limb_span R, typename Func>
 constexpr void binary_inplace(D d, R r, Func f) noexcept
 {
     constexpr std::size_t DN = D::extent;
     constexpr std::size_t RN = R::extent;
 
+    // r may begin at d, so its extension is read before d is written
+    limb_type rext = limb_span_sign_extension<RSigned>(r);
     constexpr std::size_t N = span_utils::min_extent({DN, RN});
-    binary_inplace_unroll<N>(d.begin(), r.begin(), f, std::min(d.size(), r.size()));
+    binary_inplace_unroll<Restrict, N>(d.begin(), r.begin(), f, std::min(d.size(), r.size()));
     if constexpr (std::max(DN, RN) == std::dynamic_extent || DN > RN) {
         if (d.size() <= r.size()) {
             return;
         }
 
         auto dtail = span_utils::skip<RN>(d, r.size());
-        binary_inplace<Branchless, RSigned>(dtail, limb_span_sign_extension<RSigned>(r), f);
+        binary_inplace<Branchless, RSigned>(dtail, rext, f);
     }
 }
 
-template<bool Branchless, bool LSigned, bool RSigned, output_limb_span D, input_limb_span L, input_limb_span R, typename Func>
+template<bool Restrict, bool Branchless, bool LSigned, bool RSigned, output_limb_span D, input_limb_span L, input_limb_span R, typename Func>
 constexpr void binary(D d, L l, R r, Func f) noexcept
 {
     constexpr std::size_t DN = D::extent;
@@ -343,8 +1221,12 @@ constexpr void binary(D d, L l, R r, Func f) noexcept
 
     constexpr std::size_t N = span_utils::min_extent({DN, LN, RN});
 
+    // d may begin at an operand, so the extensions are read before d is written
+    limb_type lext = limb_span_sign_extension<LSigned>(l);
+    limb_type rext = limb_span_sign_extension<RSigned>(r);
+
     std::size_t minSize = std::min({d.size(), l.size(), r.size()});
-    binary_unroll<N>(d.begin(), l.begin(), r.begin(), f, minSize);
+    binary_unroll<Restrict, N>(d.begin(), l.begin(), r.begin(), f, minSize);
     if constexpr (std::max({DN, LN, RN}) == std::dynamic_extent || DN > LN || DN > RN) {
         if (d.size() <= minSize) {
             return;
@@ -354,26 +1236,22 @@ constexpr void binary(D d, L l, R r, Func f) noexcept
             if (l.size() > r.size()) {
                 auto dtail = span_utils::skip<RN>(d, r.size());
                 auto ltail = span_utils::skip<RN>(l, r.size());
-                limb_type rext = limb_span_sign_extension<RSigned>(r);
-                binary<Branchless, LSigned, RSigned>(dtail, ltail, rext, f);
+                binary<Restrict, Branchless, LSigned, RSigned>(dtail, ltail, rext, f);
             }
         }
 
         if constexpr (LN == std::dynamic_extent || (RN > LN && DN > LN)) {
             if (l.size() < r.size()) {
                 auto dtail = span_utils::skip<LN>(d, l.size());
-                limb_type lext = limb_span_sign_extension<LSigned>(l);
                 auto rtail = span_utils::skip<LN>(r, l.size());
                 typename Func::flip flip{ };
-                binary<Branchless, RSigned, LSigned>(dtail, rtail, lext, flip);
+                binary<Restrict, Branchless, RSigned, LSigned>(dtail, rtail, lext, flip);
             }
         }
 
         if constexpr (std::max(LN, RN) == std::dynamic_extent || LN == RN) {
             if (l.size() == r.size()) {
-                limb_type lext = limb_span_sign_extension<LSigned>(l);
-                limb_type rext = limb_span_sign_extension<RSigned>(r);
-                std::fill(d.begin() + l.size(), d.end(), f(lext, rext));
+                fill_limbs(d.begin() + l.size(), d.end(), f(lext, rext));
             }
         }
     }
@@ -388,29 +1266,32 @@ constexpr void unary_inplace_dispatch(D d, Func f) noexcept
 template<limb_span_option Opt, output_limb_span D, input_limb_span R, typename Func>
 constexpr void unary_dispatch(D d, R r, Func f) noexcept
 {
+    constexpr bool Restrict = static_cast<bool>(Opt & restrict_dest_arg_option);
     constexpr bool RSigned = static_cast<bool>(Opt & right_signed_option);
     std::span<const limb_type, R::extent> r2 = r;
-    _detail_limb_span_bitwise::unary<RSigned>(d, r2, f);
+    _detail_limb_span_bitwise::unary<Restrict, RSigned>(d, r2, f);
 }
 
 template<limb_span_option Opt, output_limb_span D, input_limb_span R, typename Func>
 constexpr void binary_inplace_dispatch(D d, R r, Func f) noexcept
 {
+    constexpr bool Restrict = static_cast<bool>(Opt & restrict_dest_right_option);
     constexpr bool Branchless = static_cast<bool>(Opt & branchless_option);
     constexpr bool RSigned = static_cast<bool>(Opt & right_signed_option);
     std::span<const limb_type, R::extent> r2 = r;
-    _detail_limb_span_bitwise::binary_inplace<Branchless, RSigned>(d, r2, f);
+    _detail_limb_span_bitwise::binary_inplace<Restrict, Branchless, RSigned>(d, r2, f);
 }
 
 template<limb_span_option Opt, output_limb_span D, input_limb_span L, input_limb_span R, typename Func>
 constexpr void binary_dispatch(D d, L l, R r, Func f) noexcept
 {
+    constexpr bool Restrict = (Opt & (restrict_dest_left_option | restrict_dest_right_option)) == (restrict_dest_left_option | restrict_dest_right_option);
     constexpr bool Branchless = static_cast<bool>(Opt & branchless_option);
     constexpr bool LSigned = static_cast<bool>(Opt & left_signed_option);
     constexpr bool RSigned = static_cast<bool>(Opt & right_signed_option);
     std::span<const limb_type, L::extent> l2 = l;
     std::span<const limb_type, R::extent> r2 = r;
-    _detail_limb_span_bitwise::binary<Branchless, LSigned, RSigned>(d, l2, r2, f);
+    _detail_limb_span_bitwise::binary<Restrict, Branchless, LSigned, RSigned>(d, l2, r2, f);
 }
 
 }
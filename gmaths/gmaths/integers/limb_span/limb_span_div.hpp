@@ -0,0 +1,670 @@
+#ifndef GMATHS_INTEGERS_LIMB_SPAN_DIV_HPP_INCLUDED
+#define GMATHS_INTEGERS_LIMB_SPAN_DIV_HPP_INCLUDED
+
+/**
+ * @file gmaths/integers/limb_span/limb_span_div.hpp
+ * @brief Provides division with remainder of the numeric values stored in
+ * limb_spans.
+ *
+ * ::limb_span_divrem_1() divides by a single limb and ::limb_span_divrem()
+ * divides by a limb_span of arbitrary size. Both treat their operands as
+ * unsigned integers and use the reciprocal of the normalized divisor, see
+ * ::limb_div_preinv(), so that no division instructions are executed apart
+ * from the one computing the reciprocal.
+ *
+ * Above `GMATHS_DIV_BZ_THRESHOLD` limbs of divisor and quotient,
+ * ::limb_span_divrem() switches from schoolbook division to the recursive
+ * algorithm of Burnikel and Ziegler, which reduces division to
+ * multiplication.
+ *
+ * ::limb_divisor stores the normalized divisor together with its reciprocal,
+ * so that dividing many values by the same limb does not compute them again.
+ */
+
+#include <gmaths/integers/limb_span/limb_span_base.hpp>
+#include <gmaths/integers/limb_span/limb_span_compare.hpp>
+#include <gmaths/integers/limb_span/limb_span_mul.hpp>
+#include <gmaths/integers/limb_span/limb_span_scratch.hpp>
+#include <gmaths/integers/limb_span/limb_span_shift.hpp>
+
+
+/**
+ * @def GMATHS_DIV_BZ_THRESHOLD
+ * @brief Number of limbs of divisor and quotient from which on
+ * ::limb_span_divrem() uses Burnikel-Ziegler division instead of schoolbook
+ * division.
+ */
+#ifndef GMATHS_DIV_BZ_THRESHOLD
+#define GMATHS_DIV_BZ_THRESHOLD 50
+#endif
+
+namespace gmaths::integers
+{
+
+namespace _detail_limb_span_div
+{
+
+using dspan = std::span<limb_type>;
+using cspan = std::span<const limb_type>;
+
+constexpr std::size_t dyn = std::dynamic_extent;
+
+constexpr std::size_t bz_threshold = GMATHS_DIV_BZ_THRESHOLD;
+
+static_assert(bz_threshold >= 4, "Burnikel-Ziegler division requires at least 4 limbs");
+
+template<typename T>
+constexpr std::span<T> subspan(std::span<T> arg, std::size_t offset, std::size_t n) noexcept
+{
+    return span_utils::first<dyn>(span_utils::skip<dyn>(arg, offset), n);
+}
+
+/*
+ * Number of limbs without the leading zero limbs.
+ */
+template<input_limb_span L>
+constexpr std::size_t normalized_size(L l) noexcept
+{
+    std::size_t n = l.size();
+    while (n > 0 && l[n - 1] == 0) {
+        --n;
+    }
+    return n;
+}
+
+/*
+ * Divides `l` by the normalized limb `r` shifted right by `shift` bits. The
+ * dividend is shifted left by the same amount on the fly, with the bits
+ * shifted out of the top limb forming the initial remainder. Quotient limbs
+ * are only stored if they fit into `q`, which may be the same span as `l`.
+ * Returns the remainder.
+ */
+constexpr limb_type divrem_1_norm(dspan q, cspan l, limb_type r, limb_type v, int shift) noexcept
+{
+    std::size_t qn = q.size();
+    limb_type rem = 0;
+    if (shift == 0) {
+        for (std::size_t i = l.size(); i-- > 0; ) {
+            limb_type qi = limb_div_preinv(rem, l[i], r, v, &rem);
+            if (i < qn) {
+                q[i] = qi;
+            }
+        }
+        return rem;
+    }
+
+    std::size_t n = l.size();
+    rem = l[n - 1] >> (limb_bits - shift);
+    for (std::size_t i = n - 1; i > 0; --i) {
+        limb_type qi = limb_div_preinv(rem, l[i] << shift | l[i - 1] >> (limb_bits - shift), r, v, &rem);
+        if (i < qn) {
+            q[i] = qi;
+        }
+    }
+    limb_type q0 = limb_div_preinv(rem, l[0] << shift, r, v, &rem);
+    if (qn > 0) {
+        q[0] = q0;
+    }
+    return rem >> shift;
+}
+
+/*
+ * Number of powers of the limb base B that mod_1_fold() requires.
+ */
+constexpr std::size_t mod_1_fold_powers = 5;
+
+/*
+ * Folds `l` into two limbs `high:low` congruent to it modulo a divisor
+ * d < 2^61, given `c[j - 1] == B^j mod d` for j = 1, ..., 5. Every step
+ * replaces the two limbs and the next four limbs of `l` by the sum of their
+ * products with the powers. The products do not depend on each other, so
+ * that the steps are chained by one multiplication and a few additions rather
+ * than by a division. Each product is less than B * d, so the sum of five of
+ * them stays below B^2.
+ */
+constexpr void mod_1_fold(cspan l, const limb_type* c, limb_type* high, limb_type* low) noexcept
+{
+    std::size_t i = l.size() - l.size() % 4;
+    limb_type h = 0;
+    limb_type s = 0;
+    for (std::size_t j = i; j < l.size(); ++j) {
+        limb_type ph = 0;
+        limb_type pl = j == i ? l[j] : limb_mul(l[j], c[j - i - 1], &ph);
+        h += ph + limb_add(s, pl, &s);
+    }
+
+    while (i > 0) {
+        i -= 4;
+        limb_type ph = 0;
+        limb_type sh = 0;
+        limb_type sl = limb_mul(l[i + 1], c[0], l[i], &sh);
+        limb_type pl = limb_mul(l[i + 2], c[1], &ph);
+        sh += ph + limb_add(sl, pl, &sl);
+        pl = limb_mul(l[i + 3], c[2], &ph);
+        sh += ph + limb_add(sl, pl, &sl);
+        pl = limb_mul(s, c[3], &ph);
+        sh += ph + limb_add(sl, pl, &sl);
+        pl = limb_mul(h, c[4], &ph);
+        sh += ph + limb_add(sl, pl, &sl);
+        h = sh;
+        s = sl;
+    }
+    *high = h;
+    *low = s;
+}
+
+/*
+ * Knuth's Algorithm D (The Art of Computer Programming, Vol. 2, 4.3.1) with
+ * quotient limbs estimated by ::limb_div_preinv(). Requires a normalized
+ * divisor `r` of at least two limbs and `l.size() > r.size()` with the top
+ * `r.size()` limbs of `l` less than `r`.
+ *
+ * Stores the `l.size() - r.size()` limbs of the quotient in `q` as far as
+ * they fit and leaves the remainder in the low `r.size()` limbs of `l`. The
+ * limbs of `l` above the remainder are left in an unspecified state.
+ */
+constexpr void divrem_norm(dspan q, dspan l, cspan r) noexcept
+{
+    std::size_t rn = r.size();
+    assert(rn >= 2);
+    assert(l.size() > rn);
+
+    limb_type r1 = r[rn - 1];
+    limb_type r0 = r[rn - 2];
+    limb_type v = limb_reciprocal(r1, r0);
+    cspan rlow = span_utils::first<dyn>(r, rn - 2);
+
+    // the top limb of the current window is kept in n1 rather than in l
+    limb_type n1 = l[l.size() - 1];
+    for (std::size_t j = l.size() - rn; j-- > 0; ) {
+        limb_type* w = l.data() + j;
+        limb_type qj = 0;
+        if (n1 == r1 && w[rn - 1] == r0) {
+            // the estimate would overflow, the quotient limb is the largest one
+            qj = ~limb_type(0);
+            limb_span_submul_1(dspan(w, rn), r, qj);
+            n1 = w[rn - 1];
+        } else {
+            limb_type n0 = 0;
+            qj = limb_div_preinv(n1, w[rn - 1], w[rn - 2], r1, r0, v, &n1, &n0);
+            limb_type borrow = limb_span_submul_1(dspan(w, rn - 2), rlow, qj);
+            bool b0 = limb_sub(n0, borrow, &n0);
+            bool b1 = limb_sub(n1, limb_type(b0), &n1);
+            w[rn - 2] = n0;
+            if (b1) {
+                // the estimate was one too large, happens with probability 2/2^64
+                --qj;
+                bool carry = limb_span_add_inplace(dspan(w, rn - 1), span_utils::first<dyn>(r, rn - 1));
+                n1 += r1 + carry;
+            }
+        }
+        if (j < q.size()) {
+            q[j] = qj;
+        }
+    }
+    l[rn - 1] = n1;
+}
+
+/*
+ * Same as divrem_norm(), except that the top `r.size()` limbs of `l` may be
+ * greater or equal to `r`. Returns the top limb of the quotient, which is
+ * either 0 or 1.
+ */
+constexpr limb_type divrem_norm_qh(dspan q, dspan l, cspan r) noexcept
+{
+    dspan top = span_utils::last<dyn>(l, r.size());
+    limb_type qh = 0;
+    if (limb_span_compare_promoted<limb_span_option(0)>(cspan(top), r) >= 0) {
+        limb_span_sub_inplace(top, r);
+        qh = 1;
+    }
+    divrem_norm(q, l, r);
+    return qh;
+}
+
+/*
+ * Scratch space required by bz_divrem_n() for a divisor of `n` limbs.
+ */
+constexpr std::size_t bz_scratch_size(std::size_t n) noexcept
+{
+    if (n < bz_threshold) {
+        return 0;
+    }
+    std::size_t lo = n / 2;
+    std::size_t hi = n - lo;
+    return std::max({ bz_scratch_size(hi), bz_scratch_size(lo), n + limb_span_mul_scratch_size(n, hi, lo) });
+}
+
+/*
+ * Recursive division of Burnikel and Ziegler of `l` with `2 * n` limbs by the
+ * normalized divisor `r` with `n` limbs, following the formulation of GMP's
+ * divide and conquer division. Stores the low `n` limbs of the quotient in `q`
+ * and the remainder in the low `n` limbs of `l` and returns the top limb of
+ * the quotient, which is either 0 or 1.
+ *
+ * Each half of the quotient is estimated by dividing the top limbs of the
+ * current remainder by the top half of the divisor recursively. The estimate
+ * is then corrected by multiplying it with the low half of the divisor, which
+ * happens at most twice.
+ */
+constexpr limb_type bz_divrem_n(dspan q, dspan l, cspan r, dspan scratch) noexcept
+{
+    std::size_t n = r.size();
+    assert(l.size() == 2 * n);
+    assert(q.size() == n);
+    assert(scratch.size() >= bz_scratch_size(n));
+
+    if (n < bz_threshold) {
+        return divrem_norm_qh(q, l, r);
+    }
+
+    std::size_t lo = n / 2;
+    std::size_t hi = n - lo;
+    dspan tmp = span_utils::first<dyn>(scratch, n);
+    dspan mul_scratch = span_utils::skip<dyn>(scratch, n);
+
+    // high half of the quotient
+    dspan qhi = subspan(q, lo, hi);
+    limb_type qh = bz_divrem_n(qhi, subspan(l, 2 * lo, 2 * hi), subspan(r, lo, hi), scratch);
+    limb_span_mul(tmp, cspan(qhi), span_utils::first<dyn>(r, lo), mul_scratch);
+    limb_type borrow = limb_span_sub_inplace(subspan(l, lo, n), cspan(tmp));
+    if (qh != 0) {
+        borrow += limb_span_sub_inplace(subspan(l, n, lo), span_utils::first<dyn>(r, lo));
+    }
+    while (borrow != 0) {
+        qh -= limb_span_sub_inplace(qhi, limb_type(1));
+        borrow -= limb_span_add_inplace(subspan(l, lo, n), r);
+    }
+
+    // low half of the quotient
+    dspan qlo = span_utils::first<dyn>(q, lo);
+    limb_type ql = bz_divrem_n(qlo, subspan(l, hi, 2 * lo), subspan(r, hi, lo), scratch);
+    limb_span_mul(tmp, span_utils::first<dyn>(r, hi), cspan(qlo), mul_scratch);
+    borrow = limb_span_sub_inplace(span_utils::first<dyn>(l, n), cspan(tmp));
+    if (ql != 0) {
+        borrow += limb_span_sub_inplace(subspan(l, lo, hi), span_utils::first<dyn>(r, hi));
+    }
+    while (borrow != 0) {
+        limb_span_sub_inplace(qlo, limb_type(1));
+        borrow -= limb_span_add_inplace(span_utils::first<dyn>(l, n), r);
+    }
+
+    return qh;
+}
+
+/*
+ * Scratch space required by bz_divrem() for a dividend of `ln` and a divisor
+ * of `rn` limbs: the quotient, a product of `rn` limbs and the larger of the
+ * recursion and the multiplication.
+ */
+constexpr std::size_t bz_divrem_scratch_size(std::size_t ln, std::size_t rn) noexcept
+{
+    return ln - rn + rn + std::max(bz_scratch_size(rn), limb_span_mul_scratch_size(rn, rn, rn));
+}
+
+/*
+ * Same as divrem_norm(), but divides in blocks of `r.size()` quotient limbs
+ * with bz_divrem_n().
+ *
+ * The topmost block may be shorter. Its `b` quotient limbs are estimated by
+ * dividing the top `2 * b` limbs by the top `b` limbs of the divisor and
+ * corrected with the product of the estimate and the remaining limbs of the
+ * divisor, as in bz_divrem_n().
+ */
+constexpr void bz_divrem(dspan q, dspan l, cspan r, dspan scratch) noexcept
+{
+    std::size_t rn = r.size();
+    std::size_t qn = l.size() - rn;
+    assert(l.size() > rn);
+    assert(scratch.size() >= bz_divrem_scratch_size(l.size(), rn));
+
+    dspan qs = span_utils::first<dyn>(scratch, qn);
+    dspan tmp = subspan(scratch, qn, rn);
+    dspan rest = span_utils::skip<dyn>(scratch, qn + rn);
+
+    std::size_t j = qn;
+    std::size_t b = qn % rn;
+    if (b == 1) {
+        j -= b;
+        divrem_norm(subspan(qs, j, b), subspan(l, j, rn + b), r);
+    } else if (b != 0) {
+        j -= b;
+        dspan window = subspan(l, j, rn + b);
+        dspan qb = subspan(qs, j, b);
+        cspan rlo = span_utils::first<dyn>(r, rn - b);
+        limb_type qh = bz_divrem_n(qb, subspan(window, rn - b, 2 * b), span_utils::last<dyn>(r, b), rest);
+
+        limb_span_mul(tmp, cspan(qb), rlo, rest);
+        dspan wlo = span_utils::first<dyn>(window, rn);
+        limb_type borrow = limb_span_sub_inplace(wlo, cspan(tmp));
+        if (qh != 0) {
+            borrow += limb_span_sub_inplace(subspan(window, b, rn - b), rlo);
+        }
+        while (borrow != 0) {
+            qh -= limb_span_sub_inplace(qb, limb_type(1));
+            borrow -= limb_span_add_inplace(wlo, r);
+        }
+        // the top limbs of the window were less than r
+        assert(qh == 0);
+    }
+    while (j > 0) {
+        j -= rn;
+        limb_type qh = bz_divrem_n(subspan(qs, j, rn), subspan(l, j, 2 * rn), r, rest);
+        assert(qh == 0);
+        static_cast<void>(qh);
+    }
+
+    std::size_t qc = std::min(qn, q.size());
+    std::copy_n(qs.begin(), qc, q.begin());
+}
+
+}
+
+/**
+ * @brief A single limb divisor together with its normalization and
+ * reciprocal.
+ *
+ * Constructing the object executes one division instruction, all divisions
+ * by it afterwards only require multiplications. The type is a literal type
+ * and can be used in constant expressions.
+ *
+ * Dividing a limb_span is bound by the latency of the division of each limb,
+ * since it depends on the remainder of the previous one. Divisors less than
+ * 2^61 additionally store the first powers of the limb base modulo the
+ * divisor, with which ::limb_divisor::mod() reduces limb_spans without this
+ * dependency.
+ */
+class limb_divisor
+{
+public:
+    /**
+     * @brief Precomputes the normalization and the reciprocal of @p d.
+     *
+     * The behavior is undefined if @p d is zero.
+     *
+     * @param d the divisor.
+     */
+    constexpr explicit limb_divisor(limb_type d) noexcept
+        : _divisor{d}, _shift{limb_lzcount(d)}, _normalized{d << _shift}, _reciprocal{limb_reciprocal(_normalized)}
+    {
+        assert(d != 0);
+        if (_shift >= fold_shift) {
+            // B mod d is the same as (B - d) mod d
+            _powers[0] = mod(limb_type(0) - d);
+            for (std::size_t j = 1; j < _detail_limb_span_div::mod_1_fold_powers; ++j) {
+                divrem(_powers[j - 1], 0, &_powers[j]);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the divisor.
+     */
+    constexpr limb_type divisor() const noexcept { return _divisor; }
+
+    /**@{*/
+    /**
+     * @brief Divides a one or two limbs wide dividend, stores the remainder at
+     * address @p remainder and returns the quotient.
+     *
+     * The two limbs wide division requires `l_high < divisor()`, just like
+     * ::limb_div().
+     *
+     * @param l_high high part of the dividend.
+     * @param l (low part of the) dividend.
+     * @param remainder address where the remainder will be stored.
+     * @return the quotient of the division.
+     */
+    constexpr limb_type divrem(limb_type l, limb_type* remainder) const noexcept
+    {
+        return divrem(0, l, remainder);
+    }
+
+    constexpr limb_type divrem(limb_type l_high, limb_type l, limb_type* remainder) const noexcept
+    {
+        assert(l_high < _divisor);
+        limb_type high = _shift == 0 ? l_high : l_high << _shift | l >> (limb_bits - _shift);
+        limb_type q = limb_div_preinv(high, l << _shift, _normalized, _reciprocal, remainder);
+        *remainder >>= _shift;
+        return q;
+    }
+    /**@}*/
+
+    /**
+     * @brief Returns the quotient of @p l and the divisor.
+     */
+    constexpr limb_type div(limb_type l) const noexcept
+    {
+        limb_type rem = 0;
+        return divrem(l, &rem);
+    }
+
+    /**
+     * @brief Returns the remainder of @p l modulo the divisor.
+     */
+    constexpr limb_type mod(limb_type l) const noexcept
+    {
+        limb_type rem = 0;
+        divrem(l, &rem);
+        return rem;
+    }
+
+    /**
+     * @brief Divides @p l by the divisor, stores the quotient in @p q and
+     * returns the remainder.
+     *
+     * The operand is treated as an unsigned integer. The quotient is truncated
+     * if @p q is smaller than @p l and extended with zeroes if it is larger.
+     * @p q may be the same span as @p l, but must not overlap with it
+     * otherwise.
+     *
+     * @param q destination of the quotient
+     * @param l dividend
+     * @return the remainder of the division
+     */
+    template<output_limb_span Q, input_limb_span L>
+    constexpr limb_type divrem(Q q, L l) const noexcept
+    {
+        limb_type rem = 0;
+        if (!l.empty()) {
+            rem = _detail_limb_span_div::divrem_1_norm(q, l, _normalized, _reciprocal, _shift);
+        }
+        std::fill(q.begin() + std::min(l.size(), q.size()), q.end(), limb_type(0));
+        return rem;
+    }
+
+    /**
+     * @brief Divides @p l by the divisor and stores the quotient in @p q.
+     *
+     * Same as ::limb_divisor::divrem(), but discards the remainder.
+     */
+    template<output_limb_span Q, input_limb_span L>
+    constexpr void div(Q q, L l) const noexcept
+    {
+        divrem(q, l);
+    }
+
+    /**
+     * @brief Returns the remainder of @p l modulo the divisor.
+     *
+     * The operand is treated as an unsigned integer.
+     */
+    template<input_limb_span L>
+    constexpr limb_type mod(L l) const noexcept
+    {
+        if (l.empty()) {
+            return 0;
+        }
+        if (_shift >= fold_shift && l.size() >= fold_threshold) {
+            limb_type high = 0;
+            limb_type low = 0;
+            _detail_limb_span_div::mod_1_fold(l, _powers, &high, &low);
+            limb_type rem = 0;
+            divrem(high, &rem);
+            divrem(rem, low, &rem);
+            return rem;
+        }
+        return _detail_limb_span_div::divrem_1_norm(std::span<limb_type>(), l, _normalized, _reciprocal, _shift);
+    }
+
+private:
+    /*
+     * mod_1_fold() requires divisors less than 2^61 and saves little on short
+     * spans, which it reduces to two limbs with two more divisions.
+     */
+    static constexpr int fold_shift = 3;
+    static constexpr std::size_t fold_threshold = 8;
+
+    limb_type _divisor;
+    int _shift;
+    limb_type _normalized;
+    limb_type _reciprocal;
+    limb_type _powers[_detail_limb_span_div::mod_1_fold_powers]{ };
+};
+
+/**
+ * @brief Divides @p l by the single limb @p r, stores the quotient in @p q
+ * and returns the remainder.
+ *
+ * The operands are treated as unsigned integers. The quotient is truncated
+ * if @p q is smaller than @p l and extended with zeroes if it is larger.
+ * @p q may be the same span as @p l, but must not overlap with it otherwise.
+ *
+ * The behavior is undefined if @p r is zero. Use ::limb_divisor when dividing
+ * by the same limb repeatedly.
+ *
+ * @param q destination of the quotient
+ * @param l dividend
+ * @param r divisor
+ * @return the remainder of the division
+ */
+template<output_limb_span Q, input_limb_span L>
+constexpr limb_type limb_span_divrem_1(Q q, L l, limb_type r) noexcept
+{
+    assert(r != 0);
+    // the powers of a limb_divisor are of no use for the quotient
+    int shift = limb_lzcount(r);
+    limb_type rem = 0;
+    if (!l.empty()) {
+        rem = _detail_limb_span_div::divrem_1_norm(q, l, r << shift, limb_reciprocal(r << shift), shift);
+    }
+    std::fill(q.begin() + std::min(l.size(), q.size()), q.end(), limb_type(0));
+    return rem;
+}
+
+/**
+ * @brief Returns the number of limbs of scratch space that
+ * ::limb_span_divrem() requires for a dividend and a divisor of the given
+ * sizes.
+ *
+ * @param ln number of limbs of the dividend
+ * @param rn number of limbs of the divisor
+ */
+constexpr std::size_t limb_span_divrem_scratch_size(std::size_t ln, std::size_t rn) noexcept
+{
+    // leading zero limbs of the divisor enlarge the quotient, so any divisor
+    // of at least the threshold may end up being divided recursively
+    std::size_t n = ln + 1 + rn;
+    if (rn >= _detail_limb_span_div::bz_threshold && ln + 1 >= 2 * _detail_limb_span_div::bz_threshold) {
+        n += _detail_limb_span_div::bz_divrem_scratch_size(ln + 1, rn);
+    }
+    return n;
+}
+
+/**
+ * @brief Divides @p l by @p r and stores the quotient in @p q and the
+ * remainder in @p rem.
+ *
+ * The operands are treated as unsigned integers. The quotient has at most
+ * `l.size() - r.size() + 1` limbs and the remainder at most `r.size()` limbs,
+ * both are truncated if their destination is smaller and extended with zeroes
+ * if it is larger. Leading zero limbs of @p r are ignored.
+ *
+ * @p q and @p rem must not overlap with each other or with @p scratch, but may
+ * overlap with the operands.
+ *
+ * The behavior is undefined if @p r is zero.
+ *
+ * @param q destination of the quotient
+ * @param rem destination of the remainder
+ * @param l dividend
+ * @param r divisor
+ * @param scratch scratch space of at least ::limb_span_divrem_scratch_size()
+ * limbs
+ */
+template<output_limb_span Q, output_limb_span M, input_limb_span L, input_limb_span R, output_limb_span S>
+constexpr void limb_span_divrem(Q q, M rem, L l, R r, S scratch) noexcept
+{
+    constexpr std::size_t dyn = std::dynamic_extent;
+    using namespace _detail_limb_span_div;
+
+    std::size_t rn = normalized_size(r);
+    std::size_t ln = normalized_size(l);
+    assert(rn > 0);
+    assert(scratch.size() >= limb_span_divrem_scratch_size(ln, rn));
+
+    std::span<limb_type> s = scratch;
+    std::span<limb_type> u = span_utils::first<dyn>(s, ln + 1);
+    std::span<limb_type> d = span_utils::first<dyn>(span_utils::skip<dyn>(s, ln + 1), rn);
+
+    if (ln < rn) {
+        // copy through the scratch space in case rem overlaps with l
+        std::copy_n(l.begin(), ln, u.begin());
+        std::fill(q.begin(), q.end(), limb_type(0));
+        std::size_t mn = std::min(ln, rem.size());
+        std::copy_n(u.begin(), mn, rem.begin());
+        std::fill(rem.begin() + mn, rem.end(), limb_type(0));
+        return;
+    }
+
+    if (rn == 1) {
+        std::span<limb_type> uq = span_utils::first<dyn>(u, ln);
+        limb_type m = limb_span_divrem_1(uq, span_utils::first<dyn>(std::span<const limb_type>(l), ln), r[0]);
+        std::size_t qn = std::min(ln, q.size());
+        std::copy_n(uq.begin(), qn, q.begin());
+        std::fill(q.begin() + qn, q.end(), limb_type(0));
+        if (!rem.empty()) {
+            rem[0] = m;
+            std::fill(rem.begin() + 1, rem.end(), limb_type(0));
+        }
+        return;
+    }
+
+    // normalize both operands, the dividend gets an additional limb
+    int shift = limb_lzcount(r[rn - 1]);
+    limb_span_shl(u, span_utils::first<dyn>(std::span<const limb_type>(l), ln), shift);
+    limb_span_shl(d, span_utils::first<dyn>(std::span<const limb_type>(r), rn), shift);
+
+    // the operands are no longer needed, so q and rem may overlap with them
+    std::size_t qn = ln + 1 - rn;
+    if (rn >= bz_threshold && qn >= bz_threshold) {
+        bz_divrem(q, u, d, span_utils::skip<dyn>(s, ln + 1 + rn));
+    } else {
+        divrem_norm(q, u, d);
+    }
+    std::fill(q.begin() + std::min(qn, q.size()), q.end(), limb_type(0));
+
+    std::span<limb_type> m = span_utils::first<dyn>(u, rn);
+    limb_span_shr_inplace(m, shift);
+    std::size_t mn = std::min(rn, rem.size());
+    std::copy_n(m.begin(), mn, rem.begin());
+    std::fill(rem.begin() + mn, rem.end(), limb_type(0));
+}
+
+/**
+ * @brief Divides @p l by @p r and stores the quotient in @p q and the
+ * remainder in @p rem.
+ *
+ * Same as the overload taking scratch space, except that the scratch space is
+ * taken from ::limb_span_scratch_arena().
+ */
+template<output_limb_span Q, output_limb_span M, input_limb_span L, input_limb_span R>
+constexpr void limb_span_divrem(Q q, M rem, L l, R r)
+{
+    limb_span_scratch scratch(limb_span_divrem_scratch_size(l.size(), r.size()));
+    limb_span_divrem(q, rem, l, r, scratch.span());
+}
+
+}
+
+#endif // !GMATHS_INTEGERS_LIMB_SPAN_DIV_HPP_INCLUDED
@@ -0,0 +1,258 @@
+#ifndef GMATHS_INTEGERS_LIMB_SPAN_MONTGOMERY_HPP_INCLUDED
+#define GMATHS_INTEGERS_LIMB_SPAN_MONTGOMERY_HPP_INCLUDED
+
+/**
+ * @file gmaths/integers/limb_span/limb_span_montgomery.hpp
+ * @brief Provides Montgomery multiplication modulo an odd modulus of a fixed
+ * number of limbs.
+ *
+ * A value `x` is represented by `x * R mod m` with `R = 2^(limb_bits * N)`.
+ * In this representation, modular multiplication does not require any
+ * division. ::montgomery_context precomputes the constants for a modulus and
+ * provides the operations on values in Montgomery form.
+ */
+
+#include <gmaths/integers/limb_span/limb_span_base.hpp>
+#include <gmaths/integers/limb_span/limb_span_div.hpp>
+#include <gmaths/integers/limb_span/limb_span_mul.hpp>
+
+#include <array>
+#include <utility>
+
+namespace gmaths::integers
+{
+
+namespace _detail_limb_span_montgomery
+{
+
+/*
+ * Calls `f(std::integral_constant<std::size_t, J>())` for all `J < N` without
+ * a loop, so that the inner loops of the multiplication are fully unrolled.
+ */
+template<std::size_t N, typename F>
+constexpr void unrolled(F&& f) noexcept
+{
+    [&]<std::size_t... J>(std::index_sequence<J...>) {
+        (f(std::integral_constant<std::size_t, J>()), ...);
+    }(std::make_index_sequence<N>());
+}
+
+/*
+ * Stores `t - m` in `d` if `t_high:t` is not less than `m`, `t` otherwise. The
+ * subtraction is always computed and the result selected by a mask, so that
+ * the running time does not depend on the values.
+ */
+template<std::size_t N>
+constexpr void final_subtract(std::span<limb_type, N> d, const std::array<limb_type, N>& t, limb_type t_high, const std::array<limb_type, N>& m) noexcept
+{
+    std::array<limb_type, N> diff{ };
+    bool borrow = false;
+    unrolled<N>([&](auto j) {
+        borrow = limb_sub(borrow, t[j], m[j], &diff[j]);
+    });
+    limb_type keep = limb_type(0) - limb_type(t_high < limb_type(borrow));
+    unrolled<N>([&](auto j) {
+        d[j] = (t[j] & keep) | (diff[j] & ~keep);
+    });
+}
+
+}
+
+/**
+ * @brief Precomputed constants for Montgomery multiplication modulo an odd
+ * modulus of @p N limbs.
+ *
+ * All operations take and return values in Montgomery form of exactly @p N
+ * limbs, which must be less than the modulus. Since @p N is known at compile
+ * time, the inner loops are fully unrolled. Destinations may overlap with the
+ * operands.
+ *
+ * @tparam N number of limbs of the modulus
+ */
+template<std::size_t N>
+class montgomery_context
+{
+    static_assert(N > 0 && N != std::dynamic_extent, "montgomery_context requires a static extent");
+
+public:
+    /**
+     * @brief Type of the values the context operates on.
+     */
+    using span_type = std::span<limb_type, N>;
+
+    /**
+     * @brief Type of the read only values the context operates on.
+     */
+    using const_span_type = std::span<const limb_type, N>;
+
+    /**
+     * @brief Precomputes `-m^-1 mod 2^limb_bits`, `R mod m` and `R^2 mod m`.
+     *
+     * The behavior is undefined if @p m is even or its top limb is zero.
+     *
+     * @param m the modulus.
+     */
+    constexpr explicit montgomery_context(const_span_type m)
+    {
+        assert(m[0] & 1);
+        assert(m[N - 1] != 0);
+        std::copy(m.begin(), m.end(), _modulus.begin());
+
+        // Newton iteration, each step doubles the number of correct low bits
+        // and m is its own inverse modulo 8
+        limb_type inv = m[0];
+        for (int bits = 3; bits < limb_bits; bits *= 2) {
+            inv *= 2 - m[0] * inv;
+        }
+        _neg_inv = limb_type(0) - inv;
+
+        std::array<limb_type, 2 * N + 1> r2{ };
+        r2[2 * N] = 1;
+        std::array<limb_type, N + 2> q{ };
+        limb_span_divrem(std::span<limb_type>(q), span_type(_r2), std::span<const limb_type>(r2), m);
+        from_mont(span_type(_one), const_span_type(_r2));
+    }
+
+    /**
+     * @brief Returns the modulus.
+     */
+    constexpr const_span_type modulus() const noexcept { return const_span_type(_modulus); }
+
+    /**
+     * @brief Returns `R mod m`, the number one in Montgomery form.
+     */
+    constexpr const_span_type one() const noexcept { return const_span_type(_one); }
+
+    /**
+     * @brief Computes `l * r / R mod m` and stores it in @p d.
+     *
+     * Uses the coarsely integrated operand scanning (CIOS) method, which
+     * interleaves the multiplication by each limb of @p r with one step of the
+     * reduction.
+     *
+     * @param d destination of the product
+     * @param l first factor
+     * @param r second factor
+     */
+    constexpr void mont_mul(span_type d, const_span_type l, const_span_type r) const noexcept
+    {
+        using _detail_limb_span_montgomery::unrolled;
+
+        // t_high:t stays below 2 * m, so t_high is at most one
+        std::array<limb_type, N> t{ };
+        limb_type t_high = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+            limb_type ri = r[i];
+            limb_type c = 0;
+            unrolled<N>([&](auto j) {
+                t[j] = limb_mul(l[j], ri, t[j], c, &c);
+            });
+            limb_type t_top = limb_add(t_high, c, &t_high);
+
+            // the low limb of t + q * m is zero by the choice of q
+            limb_type q = t[0] * _neg_inv;
+            limb_mul(q, _modulus[0], t[0], &c);
+            unrolled<N - 1>([&](auto j) {
+                t[j] = limb_mul(q, _modulus[j + 1], t[j + 1], c, &c);
+            });
+            t_high = t_top + limb_add(t_high, c, &t[N - 1]);
+        }
+        _detail_limb_span_montgomery::final_subtract<N>(d, t, t_high, _modulus);
+    }
+
+    /**
+     * @brief Computes `l * l / R mod m` and stores it in @p d.
+     *
+     * Computes the full square first, which needs about half of the
+     * multiplications of ::mont_mul for the product, and reduces it afterwards
+     * with ::mont_reduce.
+     *
+     * @param d destination of the square
+     * @param l operand
+     */
+    constexpr void mont_sqr(span_type d, const_span_type l) const noexcept
+    {
+        std::array<limb_type, 2 * N> t;
+        std::array<limb_type, limb_span_sqr_scratch_size(2 * N, N)> scratch;
+        limb_span_sqr(std::span<limb_type, 2 * N>(t), l, std::span<limb_type>(scratch));
+        reduce(d, t);
+    }
+
+    /**
+     * @brief Computes `t / R mod m` and stores it in @p d.
+     *
+     * The behavior is undefined if @p t is not less than `m * R`.
+     *
+     * @param d destination of the result
+     * @param t double width value to reduce
+     */
+    constexpr void mont_reduce(span_type d, std::span<const limb_type, 2 * N> t) const noexcept
+    {
+        std::array<limb_type, 2 * N> u;
+        std::copy(t.begin(), t.end(), u.begin());
+        reduce(d, u);
+    }
+
+    /**
+     * @brief Converts @p l to Montgomery form, that is computes `l * R mod m`
+     * and stores it in @p d.
+     *
+     * @param d destination of the value in Montgomery form
+     * @param l value less than the modulus
+     */
+    constexpr void to_mont(span_type d, const_span_type l) const noexcept
+    {
+        mont_mul(d, l, const_span_type(_r2));
+    }
+
+    /**
+     * @brief Converts @p l from Montgomery form, that is computes `l / R mod m`
+     * and stores it in @p d.
+     *
+     * @param d destination of the value
+     * @param l value in Montgomery form
+     */
+    constexpr void from_mont(span_type d, const_span_type l) const noexcept
+    {
+        std::array<limb_type, 2 * N> t{ };
+        std::copy(l.begin(), l.end(), t.begin());
+        reduce(d, t);
+    }
+
+private:
+    /*
+     * Montgomery reduction of t in place. The carry of each row is kept in
+     * the limb it cleared and added to the upper half at once.
+     */
+    constexpr void reduce(span_type d, std::array<limb_type, 2 * N>& t) const noexcept
+    {
+        using _detail_limb_span_montgomery::unrolled;
+
+        for (std::size_t i = 0; i < N; ++i) {
+            limb_type* ti = t.data() + i;
+            limb_type q = ti[0] * _neg_inv;
+            limb_type c = 0;
+            limb_mul(q, _modulus[0], ti[0], &c);
+            unrolled<N - 1>([&](auto j) {
+                ti[j + 1] = limb_mul(q, _modulus[j + 1], ti[j + 1], c, &c);
+            });
+            ti[0] = c;
+        }
+
+        std::array<limb_type, N> r;
+        bool carry = false;
+        unrolled<N>([&](auto j) {
+            carry = limb_add(carry, t[N + j], t[j], &r[j]);
+        });
+        _detail_limb_span_montgomery::final_subtract<N>(d, r, carry, _modulus);
+    }
+
+    std::array<limb_type, N> _modulus{ };
+    std::array<limb_type, N> _r2{ };
+    std::array<limb_type, N> _one{ };
+    limb_type _neg_inv = 0;
+};
+
+}
+
+#endif // !GMATHS_INTEGERS_LIMB_SPAN_MONTGOMERY_HPP_INCLUDED
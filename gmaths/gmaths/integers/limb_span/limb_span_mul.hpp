@@ -0,0 +1,1180 @@
+#ifndef GMATHS_INTEGERS_LIMB_SPAN_MUL_HPP_INCLUDED
+#define GMATHS_INTEGERS_LIMB_SPAN_MUL_HPP_INCLUDED
+
+/**
+ * @file gmaths/integers/limb_span/limb_span_mul.hpp
+ * @brief Provides multiplication of the numeric values stored in limb_spans.
+ *
+ * The row kernels ::limb_span_mul_1(), ::limb_span_addmul_1() and
+ * ::limb_span_submul_1() multiply a limb_span by a single limb. They are the
+ * building blocks of all multiplication, reduction and conversion algorithms
+ * and treat their operands as unsigned integers.
+ *
+ * ::limb_span_mul() multiplies two limb_spans and selects between schoolbook
+ * multiplication, Karatsuba, Toom-3 and Toom-4 depending on the size of the
+ * operands. The crossover points can be tuned by defining the macros
+ * `GMATHS_MUL_KARATSUBA_THRESHOLD`, `GMATHS_MUL_TOOM3_THRESHOLD` and
+ * `GMATHS_MUL_TOOM4_THRESHOLD`. The algorithms above schoolbook
+ * multiplication require scratch space which is provided by the caller, see
+ * ::limb_span_mul_scratch_size().
+ *
+ * Above `GMATHS_MUL_FFT_THRESHOLD` limbs a number theoretic transform is
+ * used instead, see limb_span_ntt.hpp. ::limb_span_mul_fft() always uses the
+ * transform and can run it on multiple threads.
+ *
+ * ::limb_span_sqr() does the same for squares. It computes the off-diagonal
+ * products of the schoolbook algorithm only once and has its own set of
+ * thresholds `GMATHS_SQR_KARATSUBA_THRESHOLD`, `GMATHS_SQR_TOOM3_THRESHOLD`,
+ * `GMATHS_SQR_TOOM4_THRESHOLD` and `GMATHS_SQR_FFT_THRESHOLD`.
+ */
+
+#include <gmaths/integers/limb_span/limb_span_add.hpp>
+#include <gmaths/integers/limb_span/limb_span_base.hpp>
+#include <gmaths/integers/limb_span/limb_span_ntt.hpp>
+#include <gmaths/integers/limb_span/limb_span_scratch.hpp>
+
+#include <utility>
+#include <vector>
+
+/**
+ * @def GMATHS_MUL_KARATSUBA_THRESHOLD
+ * @brief Number of limbs of the smaller operand from which on ::limb_span_mul()
+ * uses Karatsuba multiplication instead of schoolbook multiplication.
+ */
+#ifndef GMATHS_MUL_KARATSUBA_THRESHOLD
+#define GMATHS_MUL_KARATSUBA_THRESHOLD 32
+#endif
+
+/**
+ * @def GMATHS_MUL_TOOM3_THRESHOLD
+ * @brief Number of limbs of the smaller operand from which on ::limb_span_mul()
+ * uses Toom-3 multiplication instead of Karatsuba multiplication.
+ */
+#ifndef GMATHS_MUL_TOOM3_THRESHOLD
+#define GMATHS_MUL_TOOM3_THRESHOLD 96
+#endif
+
+/**
+ * @def GMATHS_MUL_TOOM4_THRESHOLD
+ * @brief Number of limbs of the smaller operand from which on ::limb_span_mul()
+ * uses Toom-4 multiplication instead of Toom-3 multiplication.
+ */
+#ifndef GMATHS_MUL_TOOM4_THRESHOLD
+#define GMATHS_MUL_TOOM4_THRESHOLD 256
+#endif
+
+/**
+ * @def GMATHS_MUL_FFT_THRESHOLD
+ * @brief Number of limbs from which on ::limb_span_mul() uses a number
+ * theoretic transform instead of Toom-4 multiplication.
+ */
+#ifndef GMATHS_MUL_FFT_THRESHOLD
+#define GMATHS_MUL_FFT_THRESHOLD 6000
+#endif
+
+/**
+ * @def GMATHS_SQR_KARATSUBA_THRESHOLD
+ * @brief Number of limbs from which on ::limb_span_sqr() uses Karatsuba
+ * squaring instead of schoolbook squaring.
+ */
+#ifndef GMATHS_SQR_KARATSUBA_THRESHOLD
+#define GMATHS_SQR_KARATSUBA_THRESHOLD 48
+#endif
+
+/**
+ * @def GMATHS_SQR_TOOM3_THRESHOLD
+ * @brief Number of limbs from which on ::limb_span_sqr() uses Toom-3 squaring
+ * instead of Karatsuba squaring.
+ */
+#ifndef GMATHS_SQR_TOOM3_THRESHOLD
+#define GMATHS_SQR_TOOM3_THRESHOLD 128
+#endif
+
+/**
+ * @def GMATHS_SQR_TOOM4_THRESHOLD
+ * @brief Number of limbs from which on ::limb_span_sqr() uses Toom-4 squaring
+ * instead of Toom-3 squaring.
+ */
+#ifndef GMATHS_SQR_TOOM4_THRESHOLD
+#define GMATHS_SQR_TOOM4_THRESHOLD 320
+#endif
+
+/**
+ * @def GMATHS_SQR_FFT_THRESHOLD
+ * @brief Number of limbs from which on ::limb_span_sqr() uses a number
+ * theoretic transform instead of Toom-4 squaring.
+ */
+#ifndef GMATHS_SQR_FFT_THRESHOLD
+#define GMATHS_SQR_FFT_THRESHOLD 7000
+#endif
+
+namespace gmaths::integers
+{
+
+namespace _detail_limb_span_mul
+{
+
+template<int N, typename DIt, typename LIt>
+constexpr limb_type mul_1_unroll_helper(DIt d, LIt l, limb_type r, limb_type carry, int n = N) noexcept
+{
+    limb_type l_arr[N]{ };
+    std::copy_n(l, n, l_arr);
+    for (int i = 0; i < n; ++i) {
+        l_arr[i] = limb_mul(l_arr[i], r, carry, &carry);
+    }
+    std::copy_n(l_arr, n, d);
+    return carry;
+}
+
+template<int N, typename DIt, typename LIt>
+constexpr limb_type addmul_1_unroll_helper(DIt d, LIt l, limb_type r, limb_type carry, int n = N) noexcept
+{
+    limb_type d_arr[N]{ };
+    std::copy_n(d, n, d_arr);
+    limb_type l_arr[N]{ };
+    std::copy_n(l, n, l_arr);
+    for (int i = 0; i < n; ++i) {
+        d_arr[i] = limb_mul(l_arr[i], r, d_arr[i], carry, &carry);
+    }
+    std::copy_n(d_arr, n, d);
+    return carry;
+}
+
+template<int N, typename DIt, typename LIt>
+constexpr limb_type submul_1_unroll_helper(DIt d, LIt l, limb_type r, limb_type carry, int n = N) noexcept
+{
+    limb_type d_arr[N]{ };
+    std::copy_n(d, n, d_arr);
+    limb_type l_arr[N]{ };
+    std::copy_n(l, n, l_arr);
+    for (int i = 0; i < n; ++i) {
+        // the high part of l * r + carry can only be all ones if the low part is 0, so adding the borrow cannot overflow
+        limb_type lo = limb_mul(l_arr[i], r, carry, &carry);
+        carry += limb_sub(d_arr[i], lo, &d_arr[i]);
+    }
+    std::copy_n(d_arr, n, d);
+    return carry;
+}
+
+constexpr int unroll_large = 16;
+constexpr int unroll_small = 4;
+
+struct mul_1_step
+{
+    template<int N, typename DIt, typename LIt>
+    static constexpr limb_type apply(DIt d, LIt l, limb_type r, limb_type carry, int n = N) noexcept
+    {
+        return mul_1_unroll_helper<N>(d, l, r, carry, n);
+    }
+};
+
+struct addmul_1_step
+{
+    template<int N, typename DIt, typename LIt>
+    static constexpr limb_type apply(DIt d, LIt l, limb_type r, limb_type carry, int n = N) noexcept
+    {
+        return addmul_1_unroll_helper<N>(d, l, r, carry, n);
+    }
+};
+
+struct submul_1_step
+{
+    template<int N, typename DIt, typename LIt>
+    static constexpr limb_type apply(DIt d, LIt l, limb_type r, limb_type carry, int n = N) noexcept
+    {
+        return submul_1_unroll_helper<N>(d, l, r, carry, n);
+    }
+};
+
+template<std::size_t N, typename Step, typename DIt, typename LIt>
+constexpr limb_type row_unroll(DIt d, LIt l, limb_type r, limb_type carry, std::size_t count) noexcept
+{
+    if constexpr (N != std::dynamic_extent) {
+        count = N;
+    }
+
+    if constexpr (N != std::dynamic_extent && N <= unroll_large) {
+        // short fixed rows are spelled out, compilers do not reliably unroll them
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((carry = Step::template apply<1>(d + I, l + I, r, carry)), ...);
+        }(std::make_index_sequence<N>());
+        return carry;
+    }
+
+    for (auto i = count / unroll_large; i > 0; --i, d += unroll_large, l += unroll_large)
+        carry = Step::template apply<unroll_large>(d, l, r, carry);
+    for (auto i = (count % unroll_large) / unroll_small; i > 0; --i, d += unroll_small, l += unroll_small)
+        carry = Step::template apply<unroll_small>(d, l, r, carry);
+    return Step::template apply<unroll_small>(d, l, r, carry, static_cast<int>((count % unroll_large) % unroll_small));
+}
+
+template<typename Step, output_limb_span D, input_limb_span L>
+constexpr limb_type row(D d, L l, limb_type r, limb_type carry) noexcept
+{
+    static_assert(D::extent == std::dynamic_extent || L::extent == std::dynamic_extent || D::extent >= L::extent,
+        "expecting destination range to be at least as large (in number of limbs) as the left range");
+    assert(d.size() >= l.size());
+
+    return row_unroll<L::extent, Step>(d.begin(), l.begin(), r, carry, l.size());
+}
+
+}
+
+/**
+ * @brief Multiplies @p l by the single limb @p r, adds @p carry and stores the
+ * low `l.size()` limbs of the result in @p d.
+ *
+ * @p d may be equal to @p l but must not overlap with it otherwise.
+ *
+ * @param d destination, must be at least as large as @p l
+ * @param l multiplicand
+ * @param r multiplier
+ * @param carry limb to be added to the product (defaults to 0)
+ * @return the most significant limb of the result
+ */
+template<output_limb_span D, input_limb_span L>
+constexpr limb_type limb_span_mul_1(D d, L l, limb_type r, limb_type carry = 0) noexcept
+{
+    std::span<const limb_type, L::extent> l2 = l;
+    return _detail_limb_span_mul::row<_detail_limb_span_mul::mul_1_step>(d, l2, r, carry);
+}
+
+/**
+ * @brief Multiplies @p l by the single limb @p r and adds the result to the
+ * low `l.size()` limbs of @p d.
+ *
+ * @p d may be equal to @p l but must not overlap with it otherwise.
+ *
+ * @param d summand and destination, must be at least as large as @p l
+ * @param l multiplicand
+ * @param r multiplier
+ * @param carry limb to be added to the result (defaults to 0)
+ * @return the limb that carries out of the `l.size()` limbs of @p d
+ */
+template<output_limb_span D, input_limb_span L>
+constexpr limb_type limb_span_addmul_1(D d, L l, limb_type r, limb_type carry = 0) noexcept
+{
+    std::span<const limb_type, L::extent> l2 = l;
+    return _detail_limb_span_mul::row<_detail_limb_span_mul::addmul_1_step>(d, l2, r, carry);
+}
+
+/**
+ * @brief Multiplies @p l by the single limb @p r and subtracts the result from
+ * the low `l.size()` limbs of @p d.
+ *
+ * @p d may be equal to @p l but must not overlap with it otherwise.
+ *
+ * @param d minuend and destination, must be at least as large as @p l
+ * @param l multiplicand
+ * @param r multiplier
+ * @param carry limb to be subtracted from the result (defaults to 0)
+ * @return the limb that borrows out of the `l.size()` limbs of @p d
+ */
+template<output_limb_span D, input_limb_span L>
+constexpr limb_type limb_span_submul_1(D d, L l, limb_type r, limb_type carry = 0) noexcept
+{
+    std::span<const limb_type, L::extent> l2 = l;
+    return _detail_limb_span_mul::row<_detail_limb_span_mul::submul_1_step>(d, l2, r, carry);
+}
+
+namespace _detail_limb_span_mul
+{
+
+constexpr std::size_t karatsuba_threshold = GMATHS_MUL_KARATSUBA_THRESHOLD;
+constexpr std::size_t toom3_threshold = GMATHS_MUL_TOOM3_THRESHOLD;
+constexpr std::size_t toom4_threshold = GMATHS_MUL_TOOM4_THRESHOLD;
+constexpr std::size_t fft_threshold = GMATHS_MUL_FFT_THRESHOLD;
+constexpr std::size_t sqr_karatsuba_threshold = GMATHS_SQR_KARATSUBA_THRESHOLD;
+constexpr std::size_t sqr_toom3_threshold = GMATHS_SQR_TOOM3_THRESHOLD;
+constexpr std::size_t sqr_toom4_threshold = GMATHS_SQR_TOOM4_THRESHOLD;
+constexpr std::size_t sqr_fft_threshold = GMATHS_SQR_FFT_THRESHOLD;
+
+static_assert(karatsuba_threshold >= 4, "Karatsuba multiplication requires at least 4 limbs");
+static_assert(sqr_karatsuba_threshold >= 4, "Karatsuba squaring requires at least 4 limbs");
+
+using dspan = std::span<limb_type>;
+using cspan = std::span<const limb_type>;
+constexpr std::size_t dyn = std::dynamic_extent;
+
+template<typename T>
+constexpr std::span<T> subspan(std::span<T> arg, std::size_t offset, std::size_t n) noexcept
+{
+    return span_utils::first<dyn>(span_utils::skip<dyn>(arg, offset), n);
+}
+
+/*
+ * Scratch space required by mul() for a full product of the given sizes.
+ *
+ * This is an upper bound rather than the exact amount: every algorithm above
+ * schoolbook multiplication uses at most `6 * ln + 64` limbs for itself and
+ * recurses on operands of at most `ceil(ln / 2) + 1` limbs. Unbalanced
+ * operands are multiplied in chunks of `rn` limbs, each of which requires a
+ * temporary of at most `2 * rn` limbs. The transform does not recurse.
+ */
+constexpr std::size_t mul_scratch_size(std::size_t ln, std::size_t rn) noexcept
+{
+    if (ln < rn) {
+        std::swap(ln, rn);
+    }
+    if (rn < karatsuba_threshold) {
+        return 0;
+    }
+    std::size_t s = (ln + 1) / 2;
+    if (rn <= s) {
+        // the last chunk may be shorter and take a different path
+        return 2 * rn + std::max(mul_scratch_size(rn, rn), mul_scratch_size(rn, ln % rn));
+    }
+    std::size_t toom = 6 * ln + 64 + mul_scratch_size(s + 1, s + 1);
+    if (rn >= fft_threshold) {
+        // keep the bound monotonic across the threshold, callers rely on that
+        return std::max(_detail_limb_span_ntt::scratch_size(ln + rn), toom);
+    }
+    return toom;
+}
+
+/*
+ * Scratch space required by sqr(), the same bound as for mul() applies.
+ */
+constexpr std::size_t sqr_scratch_size(std::size_t n) noexcept
+{
+    if (n < sqr_karatsuba_threshold) {
+        return 0;
+    }
+    std::size_t toom = 6 * n + 64 + sqr_scratch_size((n + 1) / 2 + 1);
+    if (n >= sqr_fft_threshold) {
+        return std::max(_detail_limb_span_ntt::scratch_size(2 * n), toom);
+    }
+    return toom;
+}
+
+/*
+ * Schoolbook multiplication. Requires `d.size() == l.size() + r.size()` and a
+ * non-empty right operand. The left operand should be the larger one, as it
+ * determines the length of the rows.
+ */
+template<output_limb_span D, input_limb_span L, input_limb_span R>
+constexpr void basecase(D d, L l, R r) noexcept
+{
+    assert(d.size() == l.size() + r.size());
+    assert(!r.empty());
+
+    d[l.size()] = limb_span_mul_1(d, l, r[0]);
+    for (std::size_t i = 1; i < r.size(); ++i) {
+        d[i + l.size()] = limb_span_addmul_1(span_utils::skip<dyn>(d, i), l, r[i]);
+    }
+}
+
+/*
+ * Schoolbook squaring. Requires `d.size() == 2 * l.size()` and a non-empty
+ * operand.
+ *
+ * The products `l[i] * l[j]` with `i < j` are computed once in the same manner
+ * as in basecase(). The result is then doubled and the squares `l[i] * l[i]`
+ * are added in a single pass.
+ */
+template<output_limb_span D, input_limb_span L>
+constexpr void sqr_basecase(D d, L l) noexcept
+{
+    std::size_t n = l.size();
+    assert(d.size() == 2 * n);
+    assert(n > 0);
+
+    d[0] = 0;
+    d[2 * n - 1] = 0;
+    if (n > 1) {
+        d[n] = limb_span_mul_1(subspan(d, 1, n - 1), span_utils::skip<dyn>(l, 1), l[0]);
+        for (std::size_t i = 1; i + 1 < n; ++i) {
+            d[n + i] = limb_span_addmul_1(subspan(d, 2 * i + 1, n - i - 1), span_utils::skip<dyn>(l, i + 1), l[i]);
+        }
+    }
+
+    limb_type shifted = 0;
+    bool carry = false;
+    for (std::size_t i = 0; i < n; ++i) {
+        limb_type lo = d[2 * i];
+        limb_type hi = d[2 * i + 1];
+        limb_type lo2 = lo << 1 | shifted;
+        limb_type hi2 = hi << 1 | lo >> (limb_bits - 1);
+        shifted = hi >> (limb_bits - 1);
+
+        // the high limb of l[i] * l[i] + lo2 is at most 2^64 - 2 and can absorb the carry
+        limb_type sq_hi = 0;
+        limb_type sq_lo = limb_mul(l[i], l[i], lo2, &sq_hi);
+        sq_hi += limb_add(carry, sq_lo, limb_type(0), &d[2 * i]);
+        carry = limb_add(sq_hi, hi2, &d[2 * i + 1]);
+    }
+}
+
+/*
+ * Schoolbook multiplication that only computes the low `d.size()` limbs of the
+ * product. Requires `d.size() < l.size() + r.size()`.
+ */
+constexpr void basecase_low(dspan d, cspan l, cspan r) noexcept
+{
+    std::size_t n = d.size();
+    assert(n < l.size() + r.size());
+
+    std::fill(d.begin(), d.end(), limb_type(0));
+    for (std::size_t i = 0; i < std::min(r.size(), n); ++i) {
+        std::size_t len = std::min(l.size(), n - i);
+        limb_type carry = limb_span_addmul_1(subspan(d, i, len), span_utils::first<dyn>(l, len), r[i]);
+        if (i + len < n) {
+            d[i + len] = carry;
+        }
+    }
+}
+
+/*
+ * basecase_low for operands and destination of static extents below the
+ * Karatsuba threshold. Every row keeps a static length, so that the whole
+ * product is unrolled.
+ */
+template<std::size_t DN, std::size_t LN, std::size_t RN>
+constexpr void basecase_low_fixed(limb_type* d, const limb_type* l, const limb_type* r) noexcept
+{
+    static_assert(DN < LN + RN);
+
+    std::fill_n(d, DN, limb_type(0));
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ([&] {
+            constexpr std::size_t len = std::min(LN, DN - I);
+            limb_type carry = limb_span_addmul_1(std::span<limb_type, len>(d + I, len), std::span<const limb_type, len>(l, len), r[I]);
+            if constexpr (I + len < DN) {
+                d[I + len] = carry;
+            }
+        }(), ...);
+    }(std::make_index_sequence<std::min(RN, DN)>());
+}
+
+/*
+ * Stores the low limbs of `src` in `dst` and fills the remaining limbs with 0.
+ */
+constexpr void copy_extend(dspan dst, cspan src) noexcept
+{
+    std::copy(src.begin(), src.end(), dst.begin());
+    std::fill(dst.begin() + src.size(), dst.end(), limb_type(0));
+}
+
+/*
+ * Adds `w * piece` to `dst` which must be strictly larger than `piece`.
+ */
+constexpr void eval_add(dspan dst, cspan piece, limb_type w) noexcept
+{
+    limb_type carry = limb_span_addmul_1(dst, piece, w);
+    limb_span_add_inplace(span_utils::skip<dyn>(dst, piece.size()), carry);
+}
+
+/*
+ * Subtracts `w * src` from the two's complement value `dst`, where `src` is
+ * unsigned and not larger than `dst`.
+ */
+constexpr void interp_submul(dspan dst, cspan src, limb_type w) noexcept
+{
+    limb_type borrow = limb_span_submul_1(dst, src, w);
+    limb_span_sub_inplace(span_utils::skip<dyn>(dst, src.size()), borrow);
+}
+
+/*
+ * Shifts the two's complement value `x` right by `k` bits, where
+ * `0 < k < limb_bits`. Only used for exact divisions by powers of two.
+ */
+constexpr void interp_shr(dspan x, int k) noexcept
+{
+    for (std::size_t i = 0; i + 1 < x.size(); ++i) {
+        x[i] = x[i] >> k | x[i + 1] << (limb_bits - k);
+    }
+    x.back() = static_cast<limb_type>(static_cast<signed_limb_type>(x.back()) >> k);
+}
+
+/*
+ * Computes the multiplicative inverse of the odd limb `d` modulo 2^limb_bits
+ * by Newton iteration. Each iteration doubles the number of correct bits,
+ * starting with 3 correct bits since `d * d == 1 (mod 8)` for any odd `d`.
+ */
+constexpr limb_type binvert_limb(limb_type d) noexcept
+{
+    assert(d & 1);
+    limb_type inv = d;
+    for (int bits = 3; bits < limb_bits; bits *= 2) {
+        inv *= 2 - d * inv;
+    }
+    return inv;
+}
+
+/*
+ * Divides the two's complement value `x` by the odd limb `d`. The division
+ * must be exact. The quotient is computed limb by limb modulo 2^limb_bits
+ * (Hensel division), so negative values are handled without extra effort.
+ */
+constexpr void interp_divexact(dspan x, limb_type d) noexcept
+{
+    limb_type inv = binvert_limb(d);
+    limb_type carry = 0;
+    for (auto& limb : x) {
+        limb_type s = 0;
+        carry = limb_sub(limb, carry, &s);
+        limb = s * inv;
+        limb_type hi = 0;
+        limb_mul(limb, d, &hi);
+        carry += hi;
+    }
+}
+
+constexpr void mul(dspan d, cspan l, cspan r, dspan scratch) noexcept;
+constexpr void sqr(dspan d, cspan l, dspan scratch) noexcept;
+
+/*
+ * Computes a subproduct of the divide and conquer algorithms below. They are
+ * shared between multiplication and squaring, in the latter case `l` and `r`
+ * are the same.
+ */
+template<bool Square>
+constexpr void product(dspan d, cspan l, cspan r, dspan scratch) noexcept
+{
+    if constexpr (Square) {
+        sqr(d, l, scratch);
+    } else {
+        mul(d, l, r, scratch);
+    }
+}
+
+/*
+ * Multiplies two two's complement values of equal size.
+ *
+ * The unsigned product of `l` and `r` differs from the signed one by
+ * `r << l.size()` if `l` is negative and by `l << r.size()` if `r` is negative
+ * (modulo the size of the product).
+ */
+template<bool Square>
+constexpr void mul_signed(dspan d, cspan l, cspan r, dspan scratch) noexcept
+{
+    product<Square>(d, l, r, scratch);
+    if (limb_span_sign_extension(l)) {
+        limb_span_sub_inplace(span_utils::skip<dyn>(d, l.size()), r);
+    }
+    if (limb_span_sign_extension(r)) {
+        limb_span_sub_inplace(span_utils::skip<dyn>(d, r.size()), l);
+    }
+}
+
+/*
+ * Karatsuba multiplication, requires `ceil(ln / 2) < rn <= ln`.
+ *
+ * With `l = l1 * B^s + l0` and `r = r1 * B^s + r0` the product is
+ * `v0 + (v1 - v0 - vinf) * B^s + vinf * B^2s` with `v0 = l0 * r0`,
+ * `vinf = l1 * r1` and `v1 = (l0 + l1) * (r0 + r1)`.
+ */
+template<bool Square>
+constexpr void karatsuba(dspan d, cspan l, cspan r, dspan scratch) noexcept
+{
+    std::size_t s = (l.size() + 1) / 2;
+    std::size_t e = s + 1;
+    assert(r.size() > s);
+    assert(scratch.size() >= 4 * e);
+
+    cspan l0 = span_utils::first<dyn>(l, s), l1 = span_utils::skip<dyn>(l, s);
+    cspan r0 = span_utils::first<dyn>(r, s), r1 = span_utils::skip<dyn>(r, s);
+
+    dspan le = subspan(scratch, 0, e);
+    dspan re = subspan(scratch, e, e);
+    dspan p1 = subspan(scratch, 2 * e, 2 * e);
+    dspan rest = span_utils::skip<dyn>(scratch, 4 * e);
+
+    copy_extend(le, l0);
+    limb_span_add_inplace(le, l1);
+    if constexpr (Square) {
+        re = le;
+    } else {
+        copy_extend(re, r0);
+        limb_span_add_inplace(re, r1);
+    }
+
+    dspan v0 = span_utils::first<dyn>(d, 2 * s);
+    dspan vinf = span_utils::skip<dyn>(d, 2 * s);
+    product<Square>(p1, le, re, rest);
+    product<Square>(v0, l0, r0, rest);
+    product<Square>(vinf, l1, r1, rest);
+
+    limb_span_sub_inplace(p1, v0);
+    limb_span_sub_inplace(p1, vinf);
+    limb_span_add_inplace(span_utils::skip<dyn>(d, s), p1);
+}
+
+/*
+ * Toom-3 multiplication, requires `2 * ceil(ln / 3) < rn <= ln`.
+ *
+ * Both operands are split into three pieces of `s` limbs and regarded as
+ * polynomials in `B^s`. The product polynomial is evaluated in the points 0,
+ * 1, -1, 2 and infinity and recovered by interpolation:
+ *
+ *     A1  = v1 - v0 - vinf          = c1 + c2 + c3
+ *     Am1 = vm1 - v0 - vinf         = -c1 + c2 - c3
+ *     c2  = (A1 + Am1) / 2
+ *     O   = (A1 - Am1) / 2          = c1 + c3
+ *     c3  = ((v2 - v0 - 16 vinf - 4 c2) / 2 - O) / 3
+ *     c1  = O - c3
+ */
+template<bool Square>
+constexpr void toom3(dspan d, cspan l, cspan r, dspan scratch) noexcept
+{
+    std::size_t s = (l.size() + 2) / 3;
+    std::size_t e = s + 1;
+    std::size_t w = 2 * e;
+    assert(r.size() > 2 * s);
+    assert(scratch.size() >= 6 * e + 3 * w);
+
+    cspan l0 = subspan(l, 0, s), l1 = subspan(l, s, s), l2 = span_utils::skip<dyn>(l, 2 * s);
+    cspan r0 = subspan(r, 0, s), r1 = subspan(r, s, s), r2 = span_utils::skip<dyn>(r, 2 * s);
+
+    dspan le1 = subspan(scratch, 0, e), lem1 = subspan(scratch, e, e), le2 = subspan(scratch, 2 * e, e);
+    dspan re1 = subspan(scratch, 3 * e, e), rem1 = subspan(scratch, 4 * e, e), re2 = subspan(scratch, 5 * e, e);
+    dspan p1 = subspan(scratch, 6 * e, w), pm1 = subspan(scratch, 6 * e + w, w), p2 = subspan(scratch, 6 * e + 2 * w, w);
+    dspan rest = span_utils::skip<dyn>(scratch, 6 * e + 3 * w);
+
+    // evaluation, the even part is temporarily stored in the slot of the evaluation in 2
+    copy_extend(le2, l0);
+    eval_add(le2, l2, 1);
+    limb_span_add(le1, le2, l1);
+    limb_span_sub(lem1, le2, l1);
+    copy_extend(le2, l0);
+    eval_add(le2, l1, 2);
+    eval_add(le2, l2, 4);
+
+    if constexpr (Square) {
+        re1 = le1;
+        rem1 = lem1;
+        re2 = le2;
+    } else {
+        copy_extend(re2, r0);
+        eval_add(re2, r2, 1);
+        limb_span_add(re1, re2, r1);
+        limb_span_sub(rem1, re2, r1);
+        copy_extend(re2, r0);
+        eval_add(re2, r1, 2);
+        eval_add(re2, r2, 4);
+    }
+
+    // pointwise multiplication
+    dspan v0 = span_utils::first<dyn>(d, 2 * s);
+    dspan vinf = span_utils::skip<dyn>(d, 4 * s);
+    mul_signed<Square>(p1, le1, re1, rest);
+    mul_signed<Square>(pm1, lem1, rem1, rest);
+    mul_signed<Square>(p2, le2, re2, rest);
+    product<Square>(v0, l0, r0, rest);
+    product<Square>(vinf, l2, r2, rest);
+
+    // interpolation, the evaluations are no longer needed and their space is reused
+    dspan c2 = span_utils::first<dyn>(scratch, w);
+    limb_span_sub_inplace(p1, v0);
+    limb_span_sub_inplace(p1, vinf);
+    limb_span_sub_inplace(pm1, v0);
+    limb_span_sub_inplace(pm1, vinf);
+    limb_span_add(c2, p1, pm1);
+    interp_shr(c2, 1);
+    limb_span_sub_inplace(p1, pm1);
+    interp_shr(p1, 1);
+    limb_span_sub_inplace(p2, v0);
+    interp_submul(p2, vinf, 16);
+    interp_submul(p2, c2, 4);
+    interp_shr(p2, 1);
+    limb_span_sub_inplace(p2, p1);
+    interp_divexact(p2, 3);
+    limb_span_sub_inplace(p1, p2);
+
+    // recomposition
+    std::fill(d.begin() + 2 * s, d.begin() + 4 * s, limb_type(0));
+    limb_span_add_inplace(span_utils::skip<dyn>(d, s), p1);
+    limb_span_add_inplace(span_utils::skip<dyn>(d, 2 * s), c2);
+    limb_span_add_inplace(span_utils::skip<dyn>(d, 3 * s), p2);
+}
+
+/*
+ * Toom-4 multiplication, requires `3 * ceil(ln / 4) < rn <= ln`.
+ *
+ * Both operands are split into four pieces of `s` limbs. The product
+ * polynomial is evaluated in the points 0, 1, -1, 2, -2, 1/2 and infinity,
+ * where the evaluation in 1/2 is scaled by 2^6 to keep it integral. After
+ * removing the contributions of v0 and vinf (A1, Am1, A2, Am2, Ah):
+ *
+ *     E1 = (A1 + Am1) / 2           = c2 + c4
+ *     O1 = (A1 - Am1) / 2           = c1 + c3 + c5
+ *     E2 = (A2 + Am2) / 8           = c2 + 4 c4
+ *     O2 = (A2 - Am2) / 4           = c1 + 4 c3 + 16 c5
+ *     c4 = (E2 - E1) / 3
+ *     c2 = E1 - c4
+ *     H  = Ah / 2 - 8 c2 - 2 c4     = 16 c1 + 4 c3 + c5
+ *     X  = (O2 - O1) / 3            = c3 + 5 c5
+ *     Y  = (H - O1) / 3             = 5 c1 + c3
+ *     c3 = (5 O1 - X - Y) / 3
+ *     Z  = (X - Y) / 5              = c5 - c1
+ *     S  = O1 - c3                  = c1 + c5
+ *     c5 = (S + Z) / 2
+ *     c1 = S - c5
+ */
+template<bool Square>
+constexpr void toom4(dspan d, cspan l, cspan r, dspan scratch) noexcept
+{
+    std::size_t s = (l.size() + 3) / 4;
+    std::size_t e = s + 1;
+    std::size_t w = 2 * e;
+    assert(r.size() > 3 * s);
+    assert(scratch.size() >= 10 * e + 5 * w);
+
+    cspan lp[4]{ subspan(l, 0, s), subspan(l, s, s), subspan(l, 2 * s, s), span_utils::skip<dyn>(l, 3 * s) };
+    cspan rp[4]{ subspan(r, 0, s), subspan(r, s, s), subspan(r, 2 * s, s), span_utils::skip<dyn>(r, 3 * s) };
+
+    // evaluations in 1, -1, 2, -2 and 1/2 for the left and right operand
+    dspan le[5]{ }, re[5]{ }, p[5]{ };
+    for (std::size_t i = 0; i < 5; ++i) {
+        le[i] = subspan(scratch, i * e, e);
+        re[i] = subspan(scratch, (5 + i) * e, e);
+        p[i] = subspan(scratch, 10 * e + i * w, w);
+    }
+    dspan rest = span_utils::skip<dyn>(scratch, 10 * e + 5 * w);
+
+    for (auto [x, xe] : { std::pair<cspan*, dspan*>{ lp, le }, std::pair<cspan*, dspan*>{ rp, re } }) {
+        if (Square && x == rp) {
+            std::copy(le, le + 5, re);
+            break;
+        }
+
+        // even and odd parts are temporarily stored in the slots of -2 and 1/2
+        copy_extend(xe[3], x[0]);
+        eval_add(xe[3], x[2], 1);
+        copy_extend(xe[4], x[1]);
+        eval_add(xe[4], x[3], 1);
+        limb_span_add(xe[0], xe[3], xe[4]);
+        limb_span_sub(xe[1], xe[3], xe[4]);
+
+        copy_extend(xe[4], x[0]);
+        eval_add(xe[4], x[2], 4);
+        std::fill(xe[2].begin(), xe[2].end(), limb_type(0));
+        eval_add(xe[2], x[1], 2);
+        eval_add(xe[2], x[3], 8);
+        limb_span_sub(xe[3], xe[4], xe[2]);
+        limb_span_add_inplace(xe[2], xe[4]);
+
+        std::fill(xe[4].begin(), xe[4].end(), limb_type(0));
+        eval_add(xe[4], x[0], 8);
+        eval_add(xe[4], x[1], 4);
+        eval_add(xe[4], x[2], 2);
+        eval_add(xe[4], x[3], 1);
+    }
+
+    // pointwise multiplication
+    dspan v0 = span_utils::first<dyn>(d, 2 * s);
+    dspan vinf = span_utils::skip<dyn>(d, 6 * s);
+    for (std::size_t i = 0; i < 5; ++i) {
+        mul_signed<Square>(p[i], le[i], re[i], rest);
+    }
+    product<Square>(v0, lp[0], rp[0], rest);
+    product<Square>(vinf, lp[3], rp[3], rest);
+
+    // interpolation, the evaluations are no longer needed and their space is reused
+    dspan t[5]{ };
+    for (std::size_t i = 0; i < 5; ++i) {
+        t[i] = subspan(scratch, i * w, w);
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        limb_span_sub_inplace(p[i], v0);
+        interp_submul(p[i], vinf, i < 2 ? 1 : 64);
+    }
+    interp_submul(p[4], v0, 64);
+    limb_span_sub_inplace(p[4], vinf);
+
+    dspan& c1 = p[0];
+    dspan& c2 = t[0];
+    dspan& c3 = t[2];
+    dspan& c4 = t[1];
+    dspan& c5 = t[3];
+
+    limb_span_add(t[0], p[0], p[1]);
+    interp_shr(t[0], 1);                      // E1
+    limb_span_sub_inplace(p[0], p[1]);
+    interp_shr(p[0], 1);                      // O1
+    limb_span_add(t[1], p[2], p[3]);
+    interp_shr(t[1], 3);                      // E2
+    limb_span_sub_inplace(p[2], p[3]);
+    interp_shr(p[2], 2);                      // O2
+    limb_span_sub_inplace(t[1], t[0]);
+    interp_divexact(t[1], 3);                 // c4
+    limb_span_sub_inplace(t[0], t[1]);        // c2
+    interp_shr(p[4], 1);
+    interp_submul(p[4], t[0], 8);
+    interp_submul(p[4], t[1], 2);             // H
+    limb_span_sub_inplace(p[2], p[0]);
+    interp_divexact(p[2], 3);                 // X
+    limb_span_sub_inplace(p[4], p[0]);
+    interp_divexact(p[4], 3);                 // Y
+    limb_span_mul_1(t[2], p[0], 5);
+    limb_span_sub_inplace(t[2], p[2]);
+    limb_span_sub_inplace(t[2], p[4]);
+    interp_divexact(t[2], 3);                 // c3
+    limb_span_sub_inplace(p[2], p[4]);
+    interp_divexact(p[2], 5);                 // Z
+    limb_span_sub_inplace(p[0], t[2]);        // S
+    limb_span_add(t[3], p[0], p[2]);
+    interp_shr(t[3], 1);                      // c5
+    limb_span_sub_inplace(p[0], t[3]);        // c1
+
+    // recomposition
+    std::fill(d.begin() + 2 * s, d.begin() + 6 * s, limb_type(0));
+    limb_span_add_inplace(span_utils::skip<dyn>(d, s), c1);
+    limb_span_add_inplace(span_utils::skip<dyn>(d, 2 * s), c2);
+    limb_span_add_inplace(span_utils::skip<dyn>(d, 3 * s), c3);
+    limb_span_add_inplace(span_utils::skip<dyn>(d, 4 * s), c4);
+    limb_span_add_inplace(span_utils::skip<dyn>(d, 5 * s), c5);
+}
+
+/*
+ * Multiplies a large operand by a small one by splitting the large operand
+ * into chunks of `rn` limbs, requires `rn <= ln`.
+ */
+constexpr void unbalanced(dspan d, cspan l, cspan r, dspan scratch) noexcept
+{
+    std::size_t rn = r.size();
+    assert(scratch.size() >= 2 * rn);
+
+    mul(span_utils::first<dyn>(d, 2 * rn), span_utils::first<dyn>(l, rn), r, scratch);
+    for (std::size_t k = rn; k < l.size(); k += rn) {
+        std::size_t c = std::min(rn, l.size() - k);
+        dspan tmp = span_utils::first<dyn>(scratch, c + rn);
+        mul(tmp, subspan(l, k, c), r, span_utils::skip<dyn>(scratch, c + rn));
+
+        dspan dlo = subspan(d, k, rn);
+        bool carry = limb_span_add(dlo, dlo, span_utils::first<dyn>(tmp, rn));
+        limb_span_add(subspan(d, k + rn, c), span_utils::skip<dyn>(tmp, rn), limb_type(carry));
+    }
+}
+
+/*
+ * Computes the full unsigned product, requires `d.size() == l.size() + r.size()`
+ * and that `d` does not overlap with the operands or the scratch space.
+ */
+constexpr void mul(dspan d, cspan l, cspan r, dspan scratch) noexcept
+{
+    assert(d.size() == l.size() + r.size());
+    assert(scratch.size() >= mul_scratch_size(l.size(), r.size()));
+
+    if (l.size() < r.size()) {
+        std::swap(l, r);
+    }
+    std::size_t ln = l.size();
+    std::size_t rn = r.size();
+
+    if (rn == 0) {
+        std::fill(d.begin(), d.end(), limb_type(0));
+    } else if (rn < karatsuba_threshold) {
+        basecase(d, l, r);
+    } else if (rn <= (ln + 1) / 2) {
+        unbalanced(d, l, r, scratch);
+    } else if (rn >= fft_threshold) {
+        _detail_limb_span_ntt::mul<false>(d, l, r, scratch);
+    } else if (rn >= toom4_threshold && rn > 3 * ((ln + 3) / 4)) {
+        toom4<false>(d, l, r, scratch);
+    } else if (rn >= toom3_threshold && rn > 2 * ((ln + 2) / 3)) {
+        toom3<false>(d, l, r, scratch);
+    } else {
+        karatsuba<false>(d, l, r, scratch);
+    }
+}
+
+/*
+ * Computes the full square, requires `d.size() == 2 * l.size()` and that `d`
+ * does not overlap with the operand or the scratch space.
+ */
+constexpr void sqr(dspan d, cspan l, dspan scratch) noexcept
+{
+    assert(d.size() == 2 * l.size());
+    assert(scratch.size() >= sqr_scratch_size(l.size()));
+
+    std::size_t n = l.size();
+    if (n == 0) {
+        return;
+    } else if (n < sqr_karatsuba_threshold) {
+        sqr_basecase(d, l);
+    } else if (n >= sqr_fft_threshold) {
+        _detail_limb_span_ntt::mul<true>(d, l, l, scratch);
+    } else if (n >= sqr_toom4_threshold && n > 3 * ((n + 3) / 4)) {
+        toom4<true>(d, l, l, scratch);
+    } else if (n >= sqr_toom3_threshold && n > 2 * ((n + 2) / 3)) {
+        toom3<true>(d, l, l, scratch);
+    } else {
+        karatsuba<true>(d, l, l, scratch);
+    }
+}
+
+/*
+ * Corrects the unsigned product `dp`, the first limbs of `d`, for negative
+ * operands and fills the remaining limbs of `d` with its sign extension.
+ */
+template<bool LSigned, bool RSigned, output_limb_span D, input_limb_span L, input_limb_span R>
+constexpr void finish_signed(D d, dspan dp, L l, R r) noexcept
+{
+    if constexpr (LSigned) {
+        if (limb_span_sign_extension(l) && l.size() < dp.size()) {
+            limb_span_sub_inplace(span_utils::skip<dyn>(dp, l.size()), r);
+        }
+    }
+    if constexpr (RSigned) {
+        if (limb_span_sign_extension(r) && r.size() < dp.size()) {
+            limb_span_sub_inplace(span_utils::skip<dyn>(dp, r.size()), l);
+        }
+    }
+
+    limb_type ext = LSigned || RSigned ? limb_span_sign_extension(dp) : 0;
+    std::fill(d.begin() + dp.size(), d.end(), ext);
+}
+
+}
+
+/**
+ * @brief Returns the number of limbs of scratch space that ::limb_span_mul()
+ * requires for operands and destination of the given sizes.
+ *
+ * The result is 0 if the smaller operand is below
+ * `GMATHS_MUL_KARATSUBA_THRESHOLD`.
+ *
+ * @param dn number of limbs of the destination
+ * @param ln number of limbs of the left operand
+ * @param rn number of limbs of the right operand
+ */
+constexpr std::size_t limb_span_mul_scratch_size(std::size_t dn, std::size_t ln, std::size_t rn) noexcept
+{
+    std::size_t pn = std::min(dn, ln + rn);
+    if (pn == ln + rn) {
+        return _detail_limb_span_mul::mul_scratch_size(ln, rn);
+    }
+
+    ln = std::min(ln, pn);
+    rn = std::min(rn, pn);
+    if (std::min(ln, rn) < _detail_limb_span_mul::karatsuba_threshold) {
+        return 0;
+    }
+    return ln + rn + _detail_limb_span_mul::mul_scratch_size(ln, rn);
+}
+
+/**
+ * @brief Computes the product of @p l and @p r and stores it in @p d.
+ *
+ * The product is truncated if @p d is smaller than `l.size() + r.size()` and
+ * extended according to the signedness of the operands if it is larger.
+ *
+ * @p d must not overlap with the operands or @p scratch.
+ *
+ * @tparam Opt tests for ::left_signed_option and ::right_signed_option
+ * @param d destination of the product
+ * @param l first factor
+ * @param r second factor
+ * @param scratch scratch space of at least ::limb_span_mul_scratch_size() limbs
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R, output_limb_span S>
+constexpr void limb_span_mul(D d, L l, R r, S scratch) noexcept
+{
+    constexpr bool LSigned = static_cast<bool>(Opt & left_signed_option);
+    constexpr bool RSigned = static_cast<bool>(Opt & right_signed_option);
+    constexpr std::size_t dyn = std::dynamic_extent;
+    assert(scratch.size() >= limb_span_mul_scratch_size(d.size(), l.size(), r.size()));
+
+    std::size_t pn = std::min(d.size(), l.size() + r.size());
+    std::span<limb_type> dp = span_utils::first<dyn>(d, pn);
+    std::span<const limb_type, L::extent> l2 = l;
+    std::span<const limb_type, R::extent> r2 = r;
+
+    if (pn == 0 || l.empty() || r.empty()) {
+        std::fill(d.begin(), d.end(), limb_type(0));
+        return;
+    }
+
+    if (pn == l.size() + r.size()) {
+        if constexpr (L::extent != dyn && R::extent != dyn && std::min(L::extent, R::extent) < _detail_limb_span_mul::karatsuba_threshold) {
+            // fixed size operands, keep the extents so that the rows can be unrolled
+            if constexpr (L::extent >= R::extent) {
+                _detail_limb_span_mul::basecase(dp, l2, r2);
+            } else {
+                _detail_limb_span_mul::basecase(dp, r2, l2);
+            }
+        } else {
+            _detail_limb_span_mul::mul(dp, l2, r2, scratch);
+        }
+    } else if constexpr (D::extent != dyn && L::extent != dyn && R::extent != dyn && D::extent < L::extent + R::extent
+        && std::min(L::extent, R::extent) < _detail_limb_span_mul::karatsuba_threshold) {
+        _detail_limb_span_mul::basecase_low_fixed<D::extent, std::min(L::extent, D::extent), std::min(R::extent, D::extent)>(dp.data(), l2.data(), r2.data());
+    } else {
+        std::span<const limb_type> lt = span_utils::first<dyn>(std::span<const limb_type>(l2), std::min(l.size(), pn));
+        std::span<const limb_type> rt = span_utils::first<dyn>(std::span<const limb_type>(r2), std::min(r.size(), pn));
+        if (std::min(lt.size(), rt.size()) < _detail_limb_span_mul::karatsuba_threshold) {
+            _detail_limb_span_mul::basecase_low(dp, lt, rt);
+        } else {
+            std::span<limb_type> tmp = span_utils::first<dyn>(std::span<limb_type>(scratch), lt.size() + rt.size());
+            _detail_limb_span_mul::mul(tmp, lt, rt, span_utils::skip<dyn>(std::span<limb_type>(scratch), tmp.size()));
+            std::copy_n(tmp.begin(), pn, dp.begin());
+        }
+    }
+
+    _detail_limb_span_mul::finish_signed<LSigned, RSigned>(d, dp, l2, r2);
+}
+
+/**
+ * @brief Computes the product of @p l and @p r and stores it in @p d.
+ *
+ * Same as the overload taking scratch space, except that the scratch space is
+ * taken from ::limb_span_scratch_arena() if the operands are large enough to
+ * require it.
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R>
+constexpr void limb_span_mul(D d, L l, R r)
+{
+    std::size_t n = limb_span_mul_scratch_size(d.size(), l.size(), r.size());
+    if (n == 0) {
+        limb_span_mul<Opt>(d, l, r, std::span<limb_type, 0>());
+    } else {
+        limb_span_scratch scratch(n);
+        limb_span_mul<Opt>(d, l, r, scratch.span());
+    }
+}
+
+/**
+ * @brief Computes the product of @p l and @p r by a number theoretic
+ * transform and stores it in @p d.
+ *
+ * Behaves like ::limb_span_mul() regardless of the size of the operands. The
+ * transforms modulo the three primes are independent and are run on up to
+ * @p threads threads, unless `GMATHS_NO_THREADS` is defined. The scratch space
+ * of about 10 times the size of the product is allocated internally.
+ *
+ * @tparam Opt tests for ::left_signed_option and ::right_signed_option
+ * @param d destination of the product
+ * @param l first factor
+ * @param r second factor
+ * @param threads maximum number of threads, at most 3 are used
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R>
+void limb_span_mul_fft(D d, L l, R r, std::size_t threads = 1)
+{
+    constexpr bool LSigned = static_cast<bool>(Opt & left_signed_option);
+    constexpr bool RSigned = static_cast<bool>(Opt & right_signed_option);
+    constexpr std::size_t dyn = std::dynamic_extent;
+
+    std::size_t pn = std::min(d.size(), l.size() + r.size());
+    std::span<limb_type> dp = span_utils::first<dyn>(d, pn);
+    std::span<const limb_type> l2 = l;
+    std::span<const limb_type> r2 = r;
+
+    if (pn == 0 || l.empty() || r.empty()) {
+        std::fill(d.begin(), d.end(), limb_type(0));
+        return;
+    }
+
+    std::span<const limb_type> lt = span_utils::first<dyn>(l2, std::min(l.size(), pn));
+    std::span<const limb_type> rt = span_utils::first<dyn>(r2, std::min(r.size(), pn));
+    std::size_t n = lt.size() + rt.size();
+    std::vector<limb_type> buffer(n + _detail_limb_span_ntt::threaded_scratch_size(n, threads));
+    std::span<limb_type> tmp = span_utils::first<dyn>(std::span<limb_type>(buffer), n);
+    _detail_limb_span_ntt::mul_threaded<false>(tmp, lt, rt, span_utils::skip<dyn>(std::span<limb_type>(buffer), n), threads);
+    std::copy_n(tmp.begin(), pn, dp.begin());
+
+    _detail_limb_span_mul::finish_signed<LSigned, RSigned>(d, dp, l2, r2);
+}
+
+/**
+ * @brief Returns the number of limbs of scratch space that ::limb_span_sqr()
+ * requires for an operand and destination of the given sizes.
+ *
+ * The result is 0 if the operand is below `GMATHS_SQR_KARATSUBA_THRESHOLD`.
+ *
+ * @param dn number of limbs of the destination
+ * @param n number of limbs of the operand
+ */
+constexpr std::size_t limb_span_sqr_scratch_size(std::size_t dn, std::size_t n) noexcept
+{
+    std::size_t pn = std::min(dn, 2 * n);
+    if (pn == 2 * n) {
+        return _detail_limb_span_mul::sqr_scratch_size(n);
+    }
+
+    n = std::min(n, pn);
+    if (n < _detail_limb_span_mul::sqr_karatsuba_threshold) {
+        return 0;
+    }
+    return 2 * n + _detail_limb_span_mul::sqr_scratch_size(n);
+}
+
+/**
+ * @brief Computes the square of @p l and stores it in @p d.
+ *
+ * The square is truncated if @p d is smaller than `2 * l.size()` and extended
+ * with zeroes if it is larger.
+ *
+ * @p d must not overlap with the operand or @p scratch.
+ *
+ * @tparam Opt tests for ::arg_signed_option
+ * @param d destination of the square
+ * @param l operand
+ * @param scratch scratch space of at least ::limb_span_sqr_scratch_size() limbs
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, output_limb_span S>
+constexpr void limb_span_sqr(D d, L l, S scratch) noexcept
+{
+    constexpr bool LSigned = static_cast<bool>(Opt & arg_signed_option);
+    constexpr std::size_t dyn = std::dynamic_extent;
+    assert(scratch.size() >= limb_span_sqr_scratch_size(d.size(), l.size()));
+
+    std::size_t pn = std::min(d.size(), 2 * l.size());
+    std::span<limb_type> dp = span_utils::first<dyn>(d, pn);
+    std::span<const limb_type, L::extent> l2 = l;
+
+    if (pn == 0) {
+        std::fill(d.begin(), d.end(), limb_type(0));
+        return;
+    }
+
+    if (pn == 2 * l.size()) {
+        if constexpr (L::extent != dyn && L::extent < _detail_limb_span_mul::sqr_karatsuba_threshold) {
+            _detail_limb_span_mul::sqr_basecase(dp, l2);
+        } else {
+            _detail_limb_span_mul::sqr(dp, l2, scratch);
+        }
+    } else {
+        std::span<const limb_type> lt = span_utils::first<dyn>(std::span<const limb_type>(l2), std::min(l.size(), pn));
+        if (lt.size() < _detail_limb_span_mul::sqr_karatsuba_threshold) {
+            _detail_limb_span_mul::basecase_low(dp, lt, lt);
+        } else {
+            std::span<limb_type> tmp = span_utils::first<dyn>(std::span<limb_type>(scratch), 2 * lt.size());
+            _detail_limb_span_mul::sqr(tmp, lt, span_utils::skip<dyn>(std::span<limb_type>(scratch), tmp.size()));
+            std::copy_n(tmp.begin(), pn, dp.begin());
+        }
+    }
+
+    if constexpr (LSigned) {
+        if (limb_span_sign_extension(l2) && l.size() < pn) {
+            limb_span_sub_inplace(span_utils::skip<dyn>(dp, l.size()), l2);
+            limb_span_sub_inplace(span_utils::skip<dyn>(dp, l.size()), l2);
+        }
+    }
+
+    std::fill(d.begin() + pn, d.end(), limb_type(0));
+}
+
+/**
+ * @brief Computes the square of @p l and stores it in @p d.
+ *
+ * Same as the overload taking scratch space, except that the scratch space is
+ * taken from ::limb_span_scratch_arena() if the operand is large enough to
+ * require it.
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L>
+constexpr void limb_span_sqr(D d, L l)
+{
+    std::size_t n = limb_span_sqr_scratch_size(d.size(), l.size());
+    if (n == 0) {
+        limb_span_sqr<Opt>(d, l, std::span<limb_type, 0>());
+    } else {
+        limb_span_scratch scratch(n);
+        limb_span_sqr<Opt>(d, l, scratch.span());
+    }
+}
+
+}
+
+#endif // !GMATHS_INTEGERS_LIMB_SPAN_MUL_HPP_INCLUDED
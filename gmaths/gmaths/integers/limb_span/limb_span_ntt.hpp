@@ -0,0 +1,490 @@
+#ifndef GMATHS_INTEGERS_LIMB_SPAN_NTT_HPP_INCLUDED
+#define GMATHS_INTEGERS_LIMB_SPAN_NTT_HPP_INCLUDED
+
+/**
+ * @file gmaths/integers/limb_span/limb_span_ntt.hpp
+ * @brief Multiplication of very large limb_spans by number theoretic
+ * transforms.
+ *
+ * The product is computed modulo three primes `p < 2^63` with
+ * `2^50 | p - 1` and recombined with the chinese remainder theorem. Every
+ * limb is used as a coefficient, which is possible as long as the
+ * coefficients of the product stay below the product of the primes, i.e. for
+ * transforms of up to 2^50 points.
+ *
+ * The transforms are recursive: passes over the whole array are only made
+ * until the remaining subtransforms fit into the cache, which are then
+ * completed one after another.
+ *
+ * This header is used by ::limb_span_mul() and ::limb_span_sqr() above
+ * `GMATHS_MUL_FFT_THRESHOLD` and `GMATHS_SQR_FFT_THRESHOLD` and by
+ * ::limb_span_mul_fft(), which can also compute the residues in parallel.
+ * Define `GMATHS_NO_THREADS` to always compute them sequentially.
+ */
+
+#include <gmaths/integers/limb_span/limb_span_base.hpp>
+#include <gmaths/integers/limb_type.hpp>
+
+#include <array>
+#include <bit>
+
+#ifndef GMATHS_NO_THREADS
+#include <thread>
+#include <vector>
+#endif
+
+namespace gmaths::integers
+{
+
+namespace _detail_limb_span_ntt
+{
+
+using dspan = std::span<limb_type>;
+using cspan = std::span<const limb_type>;
+
+constexpr std::size_t dyn = std::dynamic_extent;
+
+constexpr dspan subspan(dspan arg, std::size_t offset, std::size_t n) noexcept
+{
+    return span_utils::first<dyn>(span_utils::skip<dyn>(arg, offset), n);
+}
+
+/*
+ * Transforms of at most this many points are computed level by level, larger
+ * ones are split into two halves after a single pass.
+ */
+constexpr std::size_t block_size = std::size_t(1) << 12;
+
+/*
+ * log2 of the largest supported transform, all primes satisfy
+ * `2^max_log_size | p - 1`.
+ */
+constexpr int max_log_size = 50;
+
+constexpr std::size_t prime_count = 3;
+
+/*
+ * Arithmetic modulo an odd prime `p < 2^63`. Products are computed by
+ * Montgomery reduction with `R = 2^64`, so mul() returns `a * b / R`. Values
+ * that are only ever multiplied with other values, i.e. the roots of unity and
+ * all constants, are kept in Montgomery representation `x * R` so that mul()
+ * returns ordinary residues.
+ */
+struct modulus
+{
+    limb_type p;
+    limb_type neg_inv;
+    limb_type r2;
+
+    /*
+     * Adds p to a difference that wrapped around. The comparisons are replaced
+     * by the sign bit, which is reliable since all values are below 2^63, as
+     * the outcome is unpredictable inside of the transforms.
+     */
+    constexpr limb_type correct(limb_type a) const noexcept
+    {
+        return a + (p & static_cast<limb_type>(static_cast<signed_limb_type>(a) >> (limb_bits - 1)));
+    }
+
+    constexpr limb_type add(limb_type a, limb_type b) const noexcept
+    {
+        return correct(a + b - p);
+    }
+
+    constexpr limb_type sub(limb_type a, limb_type b) const noexcept
+    {
+        return correct(a - b);
+    }
+
+    constexpr limb_type mul(limb_type a, limb_type b) const noexcept
+    {
+        limb_type hi = 0;
+        limb_type lo = limb_mul(a, b, &hi);
+        limb_type mp_hi = 0;
+        limb_mul(lo * neg_inv, p, &mp_hi);
+        // the low halves sum to 0 modulo 2^64 and carry iff lo is not 0
+        return correct(hi + mp_hi + (lo != 0) - p);
+    }
+
+    constexpr limb_type reduce(limb_type a) const noexcept
+    {
+        // 2^64 < 3 * p for all primes in use
+        a = a >= p ? a - p : a;
+        return a >= p ? a - p : a;
+    }
+
+    constexpr limb_type to_mont(limb_type a) const noexcept
+    {
+        return mul(a, r2);
+    }
+
+    constexpr limb_type pow_mont(limb_type base_mont, limb_type e) const noexcept
+    {
+        limb_type result = to_mont(1);
+        for (; e != 0; e >>= 1) {
+            if (e & 1) {
+                result = mul(result, base_mont);
+            }
+            base_mont = mul(base_mont, base_mont);
+        }
+        return result;
+    }
+
+    constexpr limb_type inv_mont(limb_type a_mont) const noexcept
+    {
+        return pow_mont(a_mont, p - 2);
+    }
+};
+
+constexpr modulus make_modulus(limb_type p) noexcept
+{
+    limb_type inv = p;
+    for (int bits = 3; bits < limb_bits; bits *= 2) {
+        inv *= 2 - p * inv;
+    }
+
+    limb_type r1 = 0;
+    limb_div(1, 0, p, &r1);
+    limb_type hi = 0;
+    limb_type lo = limb_mul(r1, r1, &hi);
+    limb_type r2 = 0;
+    limb_div(hi, lo, p, &r2);
+
+    return modulus{ p, limb_type(0) - inv, r2 };
+}
+
+/*
+ * The primes in ascending order together with a primitive root.
+ */
+constexpr std::array<modulus, prime_count> moduli{
+    make_modulus(0x7e78000000000001),
+    make_modulus(0x7f18000000000001),
+    make_modulus(0x7fa8000000000001),
+};
+
+constexpr std::array<limb_type, prime_count> generators{ 5, 3, 3 };
+
+/*
+ * Constants of the recombination in Montgomery representation, for primes
+ * p0 < p1 < p2:
+ *
+ *     a0 = v0
+ *     a1 = (v1 - a0) / p0                  mod p1
+ *     a2 = (v2 - a0 - a1 * p0) / (p0 * p1)  mod p2
+ *     v  = a0 + a1 * p0 + a2 * p0 * p1
+ */
+struct crt_constants
+{
+    limb_type inv_p0_mod_p1;
+    limb_type p0_mod_p2;
+    limb_type inv_p01_mod_p2;
+    limb_type p01_low;
+    limb_type p01_high;
+};
+
+constexpr crt_constants make_crt_constants() noexcept
+{
+    modulus m1 = moduli[1];
+    modulus m2 = moduli[2];
+    limb_type p0 = moduli[0].p;
+
+    crt_constants result{ };
+    result.inv_p0_mod_p1 = m1.inv_mont(m1.to_mont(p0));
+    result.p0_mod_p2 = m2.to_mont(p0);
+    result.inv_p01_mod_p2 = m2.inv_mont(m2.mul(m2.to_mont(p0), m2.to_mont(m1.p)));
+    result.p01_low = limb_mul(p0, m1.p, &result.p01_high);
+    return result;
+}
+
+constexpr crt_constants crt = make_crt_constants();
+
+/*
+ * Smallest power of two that can hold `n` coefficients.
+ */
+constexpr std::size_t transform_size(std::size_t n) noexcept
+{
+    return std::bit_ceil(std::max(n, std::size_t(2)));
+}
+
+/*
+ * Scratch space required by mul() for a product of `pn` limbs: the residues
+ * for each prime, the second operand and the table of roots of unity.
+ */
+constexpr std::size_t scratch_size(std::size_t pn) noexcept
+{
+    return (prime_count + 2) * transform_size(pn);
+}
+
+/*
+ * Scratch space required by mul_threaded(). With more than one thread, every
+ * prime has its own operand and table.
+ */
+constexpr std::size_t threaded_scratch_size(std::size_t pn, std::size_t threads) noexcept
+{
+#ifndef GMATHS_NO_THREADS
+    if (threads > 1) {
+        return 3 * prime_count * transform_size(pn);
+    }
+#else
+    static_cast<void>(threads);
+#endif
+    return scratch_size(pn);
+}
+
+/*
+ * Fills the table of roots of unity for a transform of `n = tw.size()` points.
+ * The roots of order `2h` are stored at `tw[h + j] = w_2h^j` for `j < h`, so
+ * that every level reads a contiguous range. `tw[0]` is not used.
+ */
+constexpr void roots(dspan tw, modulus m, limb_type g) noexcept
+{
+    std::size_t n = tw.size();
+    std::size_t h = n / 2;
+    limb_type w = m.pow_mont(m.to_mont(g), (m.p - 1) / n);
+
+    tw[h] = m.to_mont(1);
+    for (std::size_t j = 1; j < h; ++j) {
+        tw[h + j] = m.mul(tw[h + j - 1], w);
+    }
+    // w_h^j = w_2h^(2j)
+    for (h /= 2; h >= 1; h /= 2) {
+        for (std::size_t j = 0; j < h; ++j) {
+            tw[h + j] = tw[2 * h + 2 * j];
+        }
+    }
+}
+
+/*
+ * One decimation in frequency level over `x` with half length `h`.
+ */
+constexpr void forward_level(limb_type* x, std::size_t n, std::size_t h, const limb_type* tw, modulus m) noexcept
+{
+    for (std::size_t k = 0; k < n; k += 2 * h) {
+        limb_type* a = x + k;
+        limb_type* b = a + h;
+        for (std::size_t j = 0; j < h; ++j) {
+            limb_type u = a[j];
+            limb_type v = b[j];
+            a[j] = m.add(u, v);
+            b[j] = m.mul(m.sub(u, v), tw[h + j]);
+        }
+    }
+}
+
+/*
+ * One decimation in time level over `x` with half length `h`, using the
+ * inverse roots. Since `w_2h^-j = -w_2h^(h - j)`, the table of the forward
+ * transform is read backwards and the butterfly negates the product.
+ */
+constexpr void inverse_level(limb_type* x, std::size_t n, std::size_t h, const limb_type* tw, modulus m) noexcept
+{
+    for (std::size_t k = 0; k < n; k += 2 * h) {
+        limb_type* a = x + k;
+        limb_type* b = a + h;
+        limb_type u = a[0];
+        limb_type v = b[0];
+        a[0] = m.add(u, v);
+        b[0] = m.sub(u, v);
+        for (std::size_t j = 1; j < h; ++j) {
+            u = a[j];
+            v = m.mul(b[j], tw[2 * h - j]);
+            a[j] = m.sub(u, v);
+            b[j] = m.add(u, v);
+        }
+    }
+}
+
+/*
+ * Forward transform of `n` points from natural to bit reversed order.
+ */
+constexpr void forward(limb_type* x, std::size_t n, const limb_type* tw, modulus m) noexcept
+{
+    if (n <= block_size) {
+        for (std::size_t h = n / 2; h >= 1; h /= 2) {
+            forward_level(x, n, h, tw, m);
+        }
+    } else {
+        forward_level(x, n, n / 2, tw, m);
+        forward(x, n / 2, tw, m);
+        forward(x + n / 2, n / 2, tw, m);
+    }
+}
+
+/*
+ * Inverse transform of `n` points from bit reversed to natural order, without
+ * the division by `n`.
+ */
+constexpr void inverse(limb_type* x, std::size_t n, const limb_type* tw, modulus m) noexcept
+{
+    if (n <= block_size) {
+        for (std::size_t h = 1; h < n; h *= 2) {
+            inverse_level(x, n, h, tw, m);
+        }
+    } else {
+        inverse(x, n / 2, tw, m);
+        inverse(x + n / 2, n / 2, tw, m);
+        inverse_level(x, n, n / 2, tw, m);
+    }
+}
+
+constexpr void load(dspan x, cspan src, modulus m) noexcept
+{
+    for (std::size_t i = 0; i < src.size(); ++i) {
+        x[i] = m.reduce(src[i]);
+    }
+    std::fill(x.begin() + src.size(), x.end(), limb_type(0));
+}
+
+/*
+ * Computes the coefficients of the product modulo the prime with index `k`.
+ * `out`, `tmp` and `tw` all have the size of the transform. `tmp` is not used
+ * if `Square` is set.
+ */
+template<bool Square>
+constexpr void residues(dspan out, dspan tmp, dspan tw, cspan l, cspan r, std::size_t k) noexcept
+{
+    modulus m = moduli[k];
+    std::size_t n = out.size();
+    roots(tw, m, generators[k]);
+
+    load(out, l, m);
+    forward(out.data(), n, tw.data(), m);
+    if constexpr (!Square) {
+        load(tmp, r, m);
+        forward(tmp.data(), n, tw.data(), m);
+    }
+
+    // the first mul() divides by R, the second one by n and multiplies by R
+    limb_type scale = m.mul(m.inv_mont(m.to_mont(limb_type(n))), m.r2);
+    for (std::size_t i = 0; i < n; ++i) {
+        limb_type b = Square ? out[i] : tmp[i];
+        out[i] = m.mul(m.mul(out[i], b), scale);
+    }
+
+    inverse(out.data(), n, tw.data(), m);
+}
+
+/*
+ * Recombines the residues into the coefficients and sums them up into `d`.
+ */
+constexpr void recombine(dspan d, cspan v0, cspan v1, cspan v2) noexcept
+{
+    modulus m1 = moduli[1];
+    modulus m2 = moduli[2];
+    limb_type p0 = moduli[0].p;
+
+    limb_type acc0 = 0;
+    limb_type acc1 = 0;
+    limb_type acc2 = 0;
+    std::size_t cn = std::min(d.size(), v0.size());
+    for (std::size_t i = 0; i < cn; ++i) {
+        limb_type a0 = v0[i];
+        limb_type a1 = m1.mul(m1.sub(v1[i], a0), crt.inv_p0_mod_p1);
+        limb_type t = m2.sub(m2.sub(v2[i], a0), m2.mul(a1, crt.p0_mod_p2));
+        limb_type a2 = m2.mul(t, crt.inv_p01_mod_p2);
+
+        // a0 + a1 * p0 < p0 * p1 fits into two limbs
+        limb_type x1 = 0;
+        limb_type x0 = limb_mul(a1, p0, a0, &x1);
+        limb_type y1 = 0;
+        limb_type y2 = 0;
+        limb_type y0 = limb_mul(a2, crt.p01_low, &y1);
+        limb_type z = 0;
+        y1 = limb_mul(a2, crt.p01_high, y1, &z);
+        y2 = z;
+
+        bool c = limb_add(acc0, x0, &acc0);
+        c = limb_add(c, acc1, x1, &acc1);
+        acc2 += c;
+        c = limb_add(acc0, y0, &acc0);
+        c = limb_add(c, acc1, y1, &acc1);
+        acc2 += y2 + c;
+
+        d[i] = acc0;
+        acc0 = acc1;
+        acc1 = acc2;
+        acc2 = 0;
+    }
+    for (std::size_t i = cn; i < d.size(); ++i) {
+        d[i] = acc0;
+        acc0 = acc1;
+        acc1 = 0;
+    }
+}
+
+/*
+ * Computes the full product, requires `d.size() == l.size() + r.size()` and
+ * that `d` does not overlap with the operands or the scratch space.
+ */
+template<bool Square>
+constexpr void mul(dspan d, cspan l, cspan r, dspan scratch) noexcept
+{
+    assert(d.size() == l.size() + r.size());
+    assert(scratch.size() >= scratch_size(d.size()));
+
+    std::size_t n = transform_size(d.size() - 1);
+    assert(n <= std::size_t(1) << max_log_size);
+
+    dspan tmp = span_utils::first<dyn>(scratch, n);
+    dspan tw = subspan(scratch, n, n);
+    std::array<dspan, prime_count> out{ };
+    for (std::size_t k = 0; k < prime_count; ++k) {
+        out[k] = subspan(scratch, (k + 2) * n, n);
+        residues<Square>(out[k], tmp, tw, l, r, k);
+    }
+    recombine(d, out[0], out[1], out[2]);
+}
+
+/*
+ * Same as mul(), but computes the residues for the primes on up to `threads`
+ * threads. Requires threaded_scratch_size() limbs of scratch space.
+ */
+template<bool Square>
+inline void mul_threaded(dspan d, cspan l, cspan r, dspan scratch, std::size_t threads)
+{
+#ifndef GMATHS_NO_THREADS
+    if (threads > 1) {
+        assert(d.size() == l.size() + r.size());
+        assert(scratch.size() >= threaded_scratch_size(d.size(), threads));
+
+        std::size_t n = transform_size(d.size() - 1);
+        assert(n <= std::size_t(1) << max_log_size);
+
+        std::array<dspan, prime_count> out{ };
+        auto run = [&](std::size_t k) {
+            dspan s = subspan(scratch, 3 * k * n, 3 * n);
+            out[k] = span_utils::first<dyn>(s, n);
+            residues<Square>(out[k], subspan(s, n, n), subspan(s, 2 * n, n), l, r, k);
+        };
+
+        std::vector<std::thread> workers;
+        std::size_t worker_count = std::min(threads, prime_count) - 1;
+        workers.reserve(worker_count);
+        for (std::size_t t = 0; t < worker_count; ++t) {
+            workers.emplace_back([&, t] {
+                for (std::size_t k = t + 1; k < prime_count; k += worker_count + 1) {
+                    run(k);
+                }
+            });
+        }
+        for (std::size_t k = 0; k < prime_count; k += worker_count + 1) {
+            run(k);
+        }
+        for (std::thread& w : workers) {
+            w.join();
+        }
+
+        recombine(d, out[0], out[1], out[2]);
+        return;
+    }
+#else
+    static_cast<void>(threads);
+#endif
+    mul<Square>(d, l, r, scratch);
+}
+
+}
+
+}
+
+#endif // !GMATHS_INTEGERS_LIMB_SPAN_NTT_HPP_INCLUDED
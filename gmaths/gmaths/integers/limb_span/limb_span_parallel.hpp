@@ -0,0 +1,560 @@
+#ifndef GMATHS_INTEGERS_LIMB_SPAN_PARALLEL_HPP_INCLUDED
+#define GMATHS_INTEGERS_LIMB_SPAN_PARALLEL_HPP_INCLUDED
+
+/**
+ * @file gmaths/integers/limb_span/limb_span_parallel.hpp
+ * @brief Provides overloads of the bitwise operations, addition, subtraction
+ * and comparison that run on several threads.
+ *
+ * The overloads take a utility::parallel_policy as their first argument and
+ * otherwise behave exactly like the sequential functions. The destination,
+ * or the longer operand of a comparison, is split into chunks that begin on
+ * cache line boundaries, so that no two threads write to the same cache line,
+ * and the chunks are handed to the work-stealing utility::thread_pool of the
+ * policy. Each chunk is processed by the sequential function on subspans
+ * taken with span_utils::first() and span_utils::skip().
+ *
+ * Addition and subtraction first compute every chunk without an incoming
+ * carry. The carry into each chunk is then resolved by a prefix scan over the
+ * carries the chunks generate and propagate, and a final parallel pass adds
+ * the incoming carries.
+ *
+ * Operands shorter than ::GMATHS_PARALLEL_THRESHOLD limbs are processed
+ * sequentially on the calling thread.
+ */
+
+#include <gmaths/integers/limb_span/limb_span_add.hpp>
+#include <gmaths/integers/limb_span/limb_span_base.hpp>
+#include <gmaths/integers/limb_span/limb_span_bitwise.hpp>
+#include <gmaths/integers/limb_span/limb_span_compare.hpp>
+#include <gmaths/utility/execution.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+/**
+ * @def GMATHS_PARALLEL_THRESHOLD
+ * @brief Number of limbs from which on the parallel overloads split an
+ * operation between threads.
+ *
+ * Below that size, the cost of waking the workers exceeds the gain.
+ */
+#ifndef GMATHS_PARALLEL_THRESHOLD
+#define GMATHS_PARALLEL_THRESHOLD (std::size_t(1) << 20)
+#endif
+
+/**
+ * @def GMATHS_PARALLEL_CHUNK
+ * @brief Minimum number of limbs in a chunk of a parallel operation.
+ *
+ * Operations are split into up to four chunks per thread, so that threads
+ * that finish early can steal work from the others, but not into chunks
+ * smaller than this.
+ */
+#ifndef GMATHS_PARALLEL_CHUNK
+#define GMATHS_PARALLEL_CHUNK (std::size_t(1) << 16)
+#endif
+
+namespace gmaths::integers
+{
+
+namespace _detail_limb_span_parallel
+{
+
+constexpr std::size_t parallel_threshold = GMATHS_PARALLEL_THRESHOLD;
+constexpr std::size_t min_chunk_limbs = std::max<std::size_t>(GMATHS_PARALLEL_CHUNK, 64 / sizeof(limb_type));
+constexpr std::size_t chunks_per_thread = 4;
+
+/*
+ * Splits n limbs beginning at base into chunks of roughly equal size. All
+ * boundaries between chunks lie on cache line boundaries of base.
+ */
+class chunking
+{
+public:
+    chunking(const limb_type* base, std::size_t n, std::size_t threads) noexcept
+        : _n{ n }, _count{ std::clamp<std::size_t>(n / min_chunk_limbs, 1, threads * chunks_per_thread) },
+        _phase{ static_cast<std::size_t>(reinterpret_cast<std::uintptr_t>(base) / sizeof(limb_type)) }
+    {
+    }
+
+    std::size_t size() const noexcept { return _count; }
+
+    std::size_t begin(std::size_t i) const noexcept
+    {
+        if (i == 0) {
+            return 0;
+        }
+        if (i >= _count) {
+            return _n;
+        }
+        constexpr std::size_t line = 64 / sizeof(limb_type);
+        std::size_t b = _n / _count * i;
+        return b - (b + _phase) % line;
+    }
+
+    std::size_t end(std::size_t i) const noexcept { return begin(i + 1); }
+
+private:
+    std::size_t _n;
+    std::size_t _count;
+    std::size_t _phase;
+};
+
+template<typename Span>
+constexpr auto chunk(Span s, std::size_t first, std::size_t last) noexcept
+{
+    return span_utils::first<std::dynamic_extent>(span_utils::skip<std::dynamic_extent>(s, first), last - first);
+}
+
+/*
+ * Limbs [first, last) of the operand s, extended infinitely by ext. Beyond the
+ * end of s the single limb ext stands in for the extension. Since ext is
+ * either 0 or all ones for a signed operand, it continues with itself under
+ * the signedness of s.
+ */
+template<input_limb_span S>
+constexpr std::span<const limb_type> slice(S s, const limb_type& ext, std::size_t first, std::size_t last) noexcept
+{
+    if (first >= s.size()) {
+        return std::span<const limb_type>(&ext, 1);
+    }
+    std::span<const limb_type> all = s;
+    return chunk(all, first, std::min(last, s.size()));
+}
+
+/*
+ * Calls body with the bounds of every chunk of the n limbs at base.
+ */
+template<typename Body>
+void for_each_chunk(const utility::parallel_policy& policy, const limb_type* base, std::size_t n, const Body& body)
+{
+    utility::thread_pool& pool = policy.pool();
+    chunking c(base, n, pool.concurrency());
+    pool.parallel_for(c.size(), [&](std::size_t i) noexcept { body(c.begin(i), c.end(i)); });
+}
+
+template<limb_span_option Opt, output_limb_span D, typename Func>
+void bitwise_unary_inplace(const utility::parallel_policy& policy, D d, Func f)
+{
+    if (d.size() < parallel_threshold) {
+        _detail_limb_span_bitwise::unary_inplace_dispatch<Opt>(d, f);
+        return;
+    }
+    std::span<limb_type> d2 = d;
+    for_each_chunk(policy, d2.data(), d2.size(), [&](std::size_t first, std::size_t last) noexcept {
+        _detail_limb_span_bitwise::unary_inplace_dispatch<Opt>(chunk(d2, first, last), f);
+    });
+}
+
+template<limb_span_option Opt, output_limb_span D, input_limb_span R, typename Func>
+void bitwise_unary(const utility::parallel_policy& policy, D d, R r, Func f)
+{
+    if (d.size() < parallel_threshold) {
+        _detail_limb_span_bitwise::unary_dispatch<Opt>(d, r, f);
+        return;
+    }
+    const limb_type rext = limb_span_sign_extension<static_cast<bool>(Opt & arg_signed_option)>(r);
+    std::span<limb_type> d2 = d;
+    for_each_chunk(policy, d2.data(), d2.size(), [&](std::size_t first, std::size_t last) noexcept {
+        _detail_limb_span_bitwise::unary_dispatch<Opt>(chunk(d2, first, last), slice(r, rext, first, last), f);
+    });
+}
+
+template<limb_span_option Opt, output_limb_span D, input_limb_span R, typename Func>
+void bitwise_binary_inplace(const utility::parallel_policy& policy, D d, R r, Func f)
+{
+    if (d.size() < parallel_threshold) {
+        _detail_limb_span_bitwise::binary_inplace_dispatch<Opt>(d, r, f);
+        return;
+    }
+    const limb_type rext = limb_span_sign_extension<static_cast<bool>(Opt & right_signed_option)>(r);
+    std::span<limb_type> d2 = d;
+    for_each_chunk(policy, d2.data(), d2.size(), [&](std::size_t first, std::size_t last) noexcept {
+        _detail_limb_span_bitwise::binary_inplace_dispatch<Opt>(chunk(d2, first, last), slice(r, rext, first, last), f);
+    });
+}
+
+template<limb_span_option Opt, output_limb_span D, input_limb_span L, input_limb_span R, typename Func>
+void bitwise_binary(const utility::parallel_policy& policy, D d, L l, R r, Func f)
+{
+    if (d.size() < parallel_threshold) {
+        _detail_limb_span_bitwise::binary_dispatch<Opt>(d, l, r, f);
+        return;
+    }
+    const limb_type lext = limb_span_sign_extension<static_cast<bool>(Opt & left_signed_option)>(l);
+    const limb_type rext = limb_span_sign_extension<static_cast<bool>(Opt & right_signed_option)>(r);
+    std::span<limb_type> d2 = d;
+    for_each_chunk(policy, d2.data(), d2.size(), [&](std::size_t first, std::size_t last) noexcept {
+        _detail_limb_span_bitwise::binary_dispatch<Opt>(chunk(d2, first, last), slice(l, lext, first, last), slice(r, rext, first, last), f);
+    });
+}
+
+/*
+ * Carry behavior of a chunk: it generates a carry if it produces one without
+ * an incoming carry, and propagates an incoming carry if its limbs are all
+ * ones (all zeroes for a borrow). Combining the signals of adjacent chunks is
+ * associative, so the carries into all chunks are the exclusive prefix scan
+ * of the signals below them.
+ */
+struct carry_signal
+{
+    bool generate;
+    bool propagate;
+};
+
+constexpr carry_signal combine(carry_signal low, carry_signal high) noexcept
+{
+    return { high.generate || (high.propagate && low.generate), high.propagate && low.propagate };
+}
+
+/*
+ * Adds (or subtracts) the operands chunk by chunk. The first pass computes
+ * every chunk without an incoming carry, the second one adds the carries
+ * resolved by the scan. The no overflow option does not hold for single
+ * chunks and is dropped.
+ */
+template<bool Sub, output_limb_span D, typename Chunk>
+bool carry_chunks(const utility::parallel_policy& policy, D d, const Chunk& compute)
+{
+    std::span<limb_type> d2 = d;
+    utility::thread_pool& pool = policy.pool();
+    chunking c(d2.data(), d2.size(), pool.concurrency());
+
+    std::vector<carry_signal> signals(c.size());
+    pool.parallel_for(c.size(), [&](std::size_t i) noexcept {
+        auto dc = chunk(d2, c.begin(i), c.end(i));
+        bool carry = compute(dc, c.begin(i), c.end(i));
+        constexpr limb_type absorbing = Sub ? limb_type(0) : ~limb_type(0);
+        signals[i] = { carry, std::all_of(dc.begin(), dc.end(), [](limb_type x) { return x == absorbing; }) };
+    });
+
+    std::vector<carry_signal> incoming(c.size());
+    std::exclusive_scan(signals.begin(), signals.end(), incoming.begin(), carry_signal{ false, true }, combine);
+
+    pool.parallel_for(c.size(), [&](std::size_t i) noexcept {
+        if (incoming[i].generate) {
+            auto dc = chunk(d2, c.begin(i), c.end(i));
+            if constexpr (Sub) {
+                limb_span_sub_inplace(dc, limb_type(1));
+            } else {
+                limb_span_add_inplace(dc, limb_type(1));
+            }
+        }
+    });
+    return combine(incoming.back(), signals.back()).generate;
+}
+
+template<bool Sub, limb_span_option Opt, output_limb_span D, input_limb_span L, input_limb_span R>
+bool add(const utility::parallel_policy& policy, D d, L l, R r)
+{
+    if (d.size() < parallel_threshold) {
+        return Sub ? limb_span_sub<Opt>(d, l, r) : limb_span_add<Opt>(d, l, r);
+    }
+    constexpr limb_span_option ChunkOpt = Opt & ~no_overflow_option;
+    const limb_type lext = limb_span_sign_extension<static_cast<bool>(Opt & left_signed_option)>(l);
+    const limb_type rext = limb_span_sign_extension<static_cast<bool>(Opt & right_signed_option)>(r);
+    return carry_chunks<Sub>(policy, d, [&](std::span<limb_type> dc, std::size_t first, std::size_t last) noexcept {
+        auto lc = slice(l, lext, first, last);
+        auto rc = slice(r, rext, first, last);
+        return Sub ? limb_span_sub<ChunkOpt>(dc, lc, rc) : limb_span_add<ChunkOpt>(dc, lc, rc);
+    });
+}
+
+template<bool Sub, limb_span_option Opt, output_limb_span D, input_limb_span R>
+bool add_inplace(const utility::parallel_policy& policy, D d, R r)
+{
+    if (d.size() < parallel_threshold) {
+        return Sub ? limb_span_sub_inplace<Opt>(d, r) : limb_span_add_inplace<Opt>(d, r);
+    }
+    constexpr limb_span_option ChunkOpt = Opt & ~no_overflow_option;
+    const limb_type rext = limb_span_sign_extension<static_cast<bool>(Opt & right_signed_option)>(r);
+    return carry_chunks<Sub>(policy, d, [&](std::span<limb_type> dc, std::size_t first, std::size_t last) noexcept {
+        auto rc = slice(r, rext, first, last);
+        return Sub ? limb_span_sub_inplace<ChunkOpt>(dc, rc) : limb_span_add_inplace<ChunkOpt>(dc, rc);
+    });
+}
+
+/*
+ * Compares the limbs [first, last) of the extended operands from the most
+ * significant one down, as unsigned numbers.
+ */
+template<input_limb_span L, input_limb_span R>
+constexpr std::strong_ordering compare_range(L l, limb_type lext, R r, limb_type rext, std::size_t first, std::size_t last) noexcept
+{
+    std::size_t common = std::min({ l.size(), r.size(), last });
+    for (std::size_t k = last; k > std::max(first, common); --k) {
+        limb_type a = k - 1 < l.size() ? l[k - 1] : lext;
+        limb_type b = k - 1 < r.size() ? r[k - 1] : rext;
+        if (a != b) {
+            return a <=> b;
+        }
+    }
+    for (std::size_t k = common; k > first; --k) {
+        if (l[k - 1] != r[k - 1]) {
+            return l[k - 1] <=> r[k - 1];
+        }
+    }
+    return std::strong_ordering::equal;
+}
+
+/*
+ * The signedness of the operands only matters in the most significant limb
+ * and, for the infinite comparison, in the sign extensions. If they differ
+ * there, the sequential comparison returns right away. Otherwise the most
+ * significant difference below decides, which the chunks search for in
+ * parallel. Chunks below a chunk that found a difference stop early.
+ */
+template<bool Infinite, limb_span_option Opt, input_limb_span L, input_limb_span R>
+std::strong_ordering compare(const utility::parallel_policy& policy, L l, R r)
+{
+    auto sequential = [&] {
+        return Infinite ? limb_span_compare_infinite<Opt>(l, r) : limb_span_compare_promoted<Opt>(l, r);
+    };
+    std::size_t n = std::max(l.size(), r.size());
+    if (n < parallel_threshold) {
+        return sequential();
+    }
+
+    const limb_type lext = limb_span_sign_extension<static_cast<bool>(Opt & left_signed_option)>(l);
+    const limb_type rext = limb_span_sign_extension<static_cast<bool>(Opt & right_signed_option)>(r);
+    if (compare_range(l, lext, r, rext, n - 1, n) != 0 || (Infinite && lext != rext)) {
+        return sequential();
+    }
+
+    utility::thread_pool& pool = policy.pool();
+    const limb_type* base = l.size() >= r.size() ? l.data() : r.data();
+    chunking c(base, n - 1, pool.concurrency());
+    std::vector<std::strong_ordering> results(c.size(), std::strong_ordering::equal);
+    std::atomic<std::size_t> decided{ 0 };
+    pool.parallel_for(c.size(), [&](std::size_t i) noexcept {
+        if (decided.load(std::memory_order_relaxed) > i) {
+            return;
+        }
+        results[i] = compare_range(l, lext, r, rext, c.begin(i), c.end(i));
+        if (results[i] != 0) {
+            std::size_t d = decided.load(std::memory_order_relaxed);
+            while (d < i + 1 && !decided.compare_exchange_weak(d, i + 1, std::memory_order_relaxed)) { }
+        }
+    });
+
+    for (std::size_t i = c.size(); i > 0; --i) {
+        if (results[i - 1] != 0) {
+            return results[i - 1];
+        }
+    }
+    return std::strong_ordering::equal;
+}
+
+}
+
+/**@{*/
+/**
+ * @brief Parallel overloads of the bitwise operations.
+ *
+ * @param policy selects the thread pool that runs the operation
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D>
+void limb_span_bitnot_inplace(const utility::parallel_policy& policy, D d)
+{
+    _detail_limb_span_parallel::bitwise_unary_inplace<Opt>(policy, d, _detail_limb_span_bitwise::unary_not{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span R>
+void limb_span_bitnot(const utility::parallel_policy& policy, D d, R r)
+{
+    _detail_limb_span_parallel::bitwise_unary<Opt>(policy, d, r, _detail_limb_span_bitwise::unary_not{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span R>
+void limb_span_bitand_inplace(const utility::parallel_policy& policy, D d, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary_inplace<Opt>(policy, d, r, _detail_limb_span_bitwise::binary_and{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R>
+void limb_span_bitand(const utility::parallel_policy& policy, D d, L l, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary<Opt>(policy, d, l, r, _detail_limb_span_bitwise::binary_and{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span R>
+void limb_span_bitnand_inplace(const utility::parallel_policy& policy, D d, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary_inplace<Opt>(policy, d, r, _detail_limb_span_bitwise::binary_nand{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R>
+void limb_span_bitnand(const utility::parallel_policy& policy, D d, L l, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary<Opt>(policy, d, l, r, _detail_limb_span_bitwise::binary_nand{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span R>
+void limb_span_bitor_inplace(const utility::parallel_policy& policy, D d, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary_inplace<Opt>(policy, d, r, _detail_limb_span_bitwise::binary_or{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R>
+void limb_span_bitor(const utility::parallel_policy& policy, D d, L l, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary<Opt>(policy, d, l, r, _detail_limb_span_bitwise::binary_or{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span R>
+void limb_span_bitnor_inplace(const utility::parallel_policy& policy, D d, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary_inplace<Opt>(policy, d, r, _detail_limb_span_bitwise::binary_nor{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R>
+void limb_span_bitnor(const utility::parallel_policy& policy, D d, L l, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary<Opt>(policy, d, l, r, _detail_limb_span_bitwise::binary_nor{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span R>
+void limb_span_bitxor_inplace(const utility::parallel_policy& policy, D d, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary_inplace<Opt>(policy, d, r, _detail_limb_span_bitwise::binary_xor{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R>
+void limb_span_bitxor(const utility::parallel_policy& policy, D d, L l, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary<Opt>(policy, d, l, r, _detail_limb_span_bitwise::binary_xor{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span R>
+void limb_span_bitxnor_inplace(const utility::parallel_policy& policy, D d, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary_inplace<Opt>(policy, d, r, _detail_limb_span_bitwise::binary_xnor{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R>
+void limb_span_bitxnor(const utility::parallel_policy& policy, D d, L l, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary<Opt>(policy, d, l, r, _detail_limb_span_bitwise::binary_xnor{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span R>
+void limb_span_bitless_inplace(const utility::parallel_policy& policy, D d, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary_inplace<Opt>(policy, d, r, _detail_limb_span_bitwise::binary_less{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R>
+void limb_span_bitless(const utility::parallel_policy& policy, D d, L l, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary<Opt>(policy, d, l, r, _detail_limb_span_bitwise::binary_less{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span R>
+void limb_span_bitgreater_inplace(const utility::parallel_policy& policy, D d, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary_inplace<Opt>(policy, d, r, _detail_limb_span_bitwise::binary_greater{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R>
+void limb_span_bitgreater(const utility::parallel_policy& policy, D d, L l, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary<Opt>(policy, d, l, r, _detail_limb_span_bitwise::binary_greater{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span R>
+void limb_span_bitleq_inplace(const utility::parallel_policy& policy, D d, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary_inplace<Opt>(policy, d, r, _detail_limb_span_bitwise::binary_leq{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R>
+void limb_span_bitleq(const utility::parallel_policy& policy, D d, L l, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary<Opt>(policy, d, l, r, _detail_limb_span_bitwise::binary_leq{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span R>
+void limb_span_bitgeq_inplace(const utility::parallel_policy& policy, D d, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary_inplace<Opt>(policy, d, r, _detail_limb_span_bitwise::binary_geq{ });
+}
+
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R>
+void limb_span_bitgeq(const utility::parallel_policy& policy, D d, L l, R r)
+{
+    _detail_limb_span_parallel::bitwise_binary<Opt>(policy, d, l, r, _detail_limb_span_bitwise::binary_geq{ });
+}
+/**@}*/
+
+/**
+ * @brief Parallel overload of ::limb_span_add().
+ *
+ * @param policy selects the thread pool that runs the operation
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R>
+bool limb_span_add(const utility::parallel_policy& policy, D d, L l, R r)
+{
+    return _detail_limb_span_parallel::add<false, Opt>(policy, d, l, r);
+}
+
+/**
+ * @brief Parallel overload of ::limb_span_add_inplace().
+ *
+ * @param policy selects the thread pool that runs the operation
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span R>
+bool limb_span_add_inplace(const utility::parallel_policy& policy, D d, R r)
+{
+    return _detail_limb_span_parallel::add_inplace<false, Opt>(policy, d, r);
+}
+
+/**
+ * @brief Parallel overload of ::limb_span_sub().
+ *
+ * @param policy selects the thread pool that runs the operation
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span L, input_limb_span R>
+bool limb_span_sub(const utility::parallel_policy& policy, D d, L l, R r)
+{
+    return _detail_limb_span_parallel::add<true, Opt>(policy, d, l, r);
+}
+
+/**
+ * @brief Parallel overload of ::limb_span_sub_inplace().
+ *
+ * @param policy selects the thread pool that runs the operation
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span R>
+bool limb_span_sub_inplace(const utility::parallel_policy& policy, D d, R r)
+{
+    return _detail_limb_span_parallel::add_inplace<true, Opt>(policy, d, r);
+}
+
+/**
+ * @brief Parallel overload of ::limb_span_compare_promoted().
+ *
+ * @param policy selects the thread pool that runs the operation
+ */
+template<limb_span_option Opt, input_limb_span L, input_limb_span R>
+std::strong_ordering limb_span_compare_promoted(const utility::parallel_policy& policy, L l, R r)
+{
+    return _detail_limb_span_parallel::compare<false, Opt>(policy, l, r);
+}
+
+/**
+ * @brief Parallel overload of ::limb_span_compare_infinite().
+ *
+ * @param policy selects the thread pool that runs the operation
+ */
+template<limb_span_option Opt, input_limb_span L, input_limb_span R>
+std::strong_ordering limb_span_compare_infinite(const utility::parallel_policy& policy, L l, R r)
+{
+    return _detail_limb_span_parallel::compare<true, Opt>(policy, l, r);
+}
+
+}
+
+#endif // !GMATHS_INTEGERS_LIMB_SPAN_PARALLEL_HPP_INCLUDED
@@ -0,0 +1,307 @@
+#ifndef GMATHS_INTEGERS_LIMB_SPAN_POWMOD_HPP_INCLUDED
+#define GMATHS_INTEGERS_LIMB_SPAN_POWMOD_HPP_INCLUDED
+
+/**
+ * @file gmaths/integers/limb_span/limb_span_powmod.hpp
+ * @brief Provides modular exponentiation of limb_spans.
+ */
+
+#include <gmaths/integers/limb_span/limb_span_barrett.hpp>
+#include <gmaths/integers/limb_span/limb_span_base.hpp>
+#include <gmaths/integers/limb_span/limb_span_bitcount.hpp>
+#include <gmaths/integers/limb_span/limb_span_montgomery.hpp>
+#include <gmaths/integers/limb_span/limb_span_scratch.hpp>
+
+#include <array>
+
+namespace gmaths::integers
+{
+
+namespace _detail_limb_span_powmod
+{
+
+constexpr std::size_t dyn = std::dynamic_extent;
+
+/*
+ * Window size for an exponent of the given number of bits. The limits
+ * balance the precomputed powers against the multiplications saved by the
+ * larger window.
+ */
+constexpr std::size_t window_size(std::size_t bits) noexcept
+{
+    constexpr std::size_t limits[] = { 7, 25, 81, 241, 673, 1793 };
+    std::size_t k = 1;
+    for (std::size_t limit : limits) {
+        k += bits > limit;
+    }
+    return k;
+}
+
+/*
+ * Number of powers of the base held in the table. The constant time mode
+ * additionally needs room for the entry selected from the table.
+ */
+constexpr std::size_t table_size(std::size_t k, bool Branchless) noexcept
+{
+    return Branchless ? (std::size_t(1) << k) + 1 : std::size_t(1) << (k - 1);
+}
+
+/*
+ * Extracts the len <= limb_bits / 2 bits of e starting at bit pos, which may
+ * cross a limb boundary.
+ */
+template<typename E>
+constexpr limb_type bits(E e, std::size_t pos, std::size_t len) noexcept
+{
+    std::size_t i = pos / limb_bits;
+    std::size_t s = pos % limb_bits;
+    limb_type w = e[i] >> s;
+    if (s + len > limb_bits && i + 1 < e.size()) {
+        w |= e[i + 1] << (limb_bits - s);
+    }
+    return w & ((limb_type(1) << len) - 1);
+}
+
+/*
+ * Modular arithmetic of a montgomery_context in the form used by the
+ * exponentiation.
+ */
+template<std::size_t N>
+struct montgomery_ops
+{
+    const montgomery_context<N>& ctx;
+
+    constexpr void enter(std::span<limb_type, N> d, std::span<const limb_type, N> l) const noexcept { ctx.to_mont(d, l); }
+    constexpr void leave(std::span<limb_type, N> d, std::span<const limb_type, N> l) const noexcept { ctx.from_mont(d, l); }
+    constexpr void mul(std::span<limb_type, N> d, std::span<const limb_type, N> l, std::span<const limb_type, N> r) const noexcept { ctx.mont_mul(d, l, r); }
+    constexpr void sqr(std::span<limb_type, N> d, std::span<const limb_type, N> l) const noexcept { ctx.mont_sqr(d, l); }
+    constexpr std::span<const limb_type, N> one() const noexcept { return ctx.one(); }
+};
+
+/*
+ * Modular arithmetic of a barrett_context in the form used by the
+ * exponentiation. Values are kept in their usual representation.
+ */
+template<std::size_t N>
+struct barrett_ops
+{
+    const barrett_context<N>& ctx;
+
+    constexpr void enter(std::span<limb_type, N> d, std::span<const limb_type, N> l) const noexcept { std::copy(l.begin(), l.end(), d.begin()); }
+    constexpr void leave(std::span<limb_type, N> d, std::span<const limb_type, N> l) const noexcept { std::copy(l.begin(), l.end(), d.begin()); }
+    constexpr void mul(std::span<limb_type, N> d, std::span<const limb_type, N> l, std::span<const limb_type, N> r) const noexcept { ctx.mul(d, l, r); }
+    constexpr void sqr(std::span<limb_type, N> d, std::span<const limb_type, N> l) const noexcept { ctx.sqr(d, l); }
+    constexpr std::span<const limb_type, N> one() const noexcept { return ctx.one(); }
+};
+
+/*
+ * Left to right sliding window exponentiation. Only the odd powers
+ * b, b^3, ..., b^(2^k - 1) are precomputed, and windows always end in a set
+ * bit, so each window costs a single multiplication.
+ */
+template<std::size_t N, typename Ops, typename E>
+constexpr void sliding(std::span<limb_type, N> d, std::span<const limb_type, N> b, E e, const Ops& ops, std::span<limb_type> scratch) noexcept
+{
+    auto entry = [&](std::size_t i) { return std::span<limb_type, N>(scratch.data() + i * N, N); };
+
+    std::size_t n = limb_span_bit_width(e);
+    if (n == 0) {
+        ops.leave(d, ops.one());
+        return;
+    }
+    std::size_t k = std::min(window_size(n), n);
+    std::size_t entries = std::size_t(1) << (k - 1);
+
+    ops.enter(entry(0), b);
+    if (entries > 1) {
+        ops.sqr(d, entry(0));
+        for (std::size_t i = 1; i < entries; ++i) {
+            ops.mul(entry(i), entry(i - 1), d);
+        }
+    }
+
+    // n counts the bits still to be processed
+    bool first = true;
+    while (n > 0) {
+        if (!bits(e, n - 1, 1)) {
+            ops.sqr(d, d);
+            --n;
+            continue;
+        }
+        std::size_t len = std::min(k, n);
+        limb_type w = bits(e, n - len, len);
+        std::size_t tz = limb_tzcount(w);
+        w >>= tz;
+        len -= tz;
+        if (first) {
+            std::copy_n(entry(w / 2).begin(), N, d.begin());
+            first = false;
+        } else {
+            for (std::size_t i = 0; i < len; ++i) {
+                ops.sqr(d, d);
+            }
+            ops.mul(d, d, entry(w / 2));
+        }
+        n -= len;
+    }
+    ops.leave(d, d);
+}
+
+/*
+ * Fixed window exponentiation in constant time. All windows of the exponent
+ * are processed including leading zeroes, every window costs the same
+ * squarings and one multiplication, and the table entry is selected by
+ * reading all entries. Squarings use the multiplication, whose running time
+ * does not depend on the values.
+ */
+template<std::size_t N, typename Ops, typename E>
+constexpr void fixed(std::span<limb_type, N> d, std::span<const limb_type, N> b, E e, const Ops& ops, std::span<limb_type> scratch) noexcept
+{
+    auto entry = [&](std::size_t i) { return std::span<limb_type, N>(scratch.data() + i * N, N); };
+
+    std::size_t n = e.size() * limb_bits;
+    if (n == 0) {
+        ops.leave(d, ops.one());
+        return;
+    }
+    std::size_t k = window_size(n);
+    std::size_t entries = std::size_t(1) << k;
+    std::span<limb_type, N> sel = entry(entries);
+
+    std::copy_n(ops.one().begin(), N, entry(0).begin());
+    ops.enter(entry(1), b);
+    for (std::size_t i = 2; i < entries; ++i) {
+        ops.mul(entry(i), entry(i - 1), entry(1));
+    }
+
+    auto select = [&](limb_type w) {
+        std::fill(sel.begin(), sel.end(), limb_type(0));
+        for (std::size_t i = 0; i < entries; ++i) {
+            limb_type mask = limb_type(0) - limb_type(i == w);
+            for (std::size_t j = 0; j < N; ++j) {
+                sel[j] |= entry(i)[j] & mask;
+            }
+        }
+    };
+
+    std::size_t len = n % k == 0 ? k : n % k;
+    n -= len;
+    select(bits(e, n, len));
+    std::copy_n(sel.begin(), N, d.begin());
+    while (n > 0) {
+        n -= k;
+        for (std::size_t i = 0; i < k; ++i) {
+            ops.mul(d, d, d);
+        }
+        select(bits(e, n, k));
+        ops.mul(d, d, sel);
+    }
+    ops.leave(d, d);
+}
+
+template<limb_span_option Opt, std::size_t N, typename Ops, typename E, typename S>
+constexpr void powmod(std::span<limb_type, N> d, std::span<const limb_type, N> b, E e, const Ops& ops, S scratch) noexcept
+{
+    constexpr bool Branchless = static_cast<bool>(Opt & branchless_option);
+    std::span<const limb_type, E::extent> e2 = e;
+    if constexpr (Branchless) {
+        fixed(d, b, e2, ops, std::span<limb_type>(scratch));
+    } else {
+        sliding(d, b, e2, ops, std::span<limb_type>(scratch));
+    }
+}
+
+}
+
+/**
+ * @brief Returns the minimum number of limbs of scratch space needed by
+ * ::limb_span_powmod().
+ *
+ * @tparam Opt tests for ::branchless_option
+ * @param n number of limbs of the modulus
+ * @param en number of limbs of the exponent
+ */
+template<limb_span_option Opt = limb_span_option(0)>
+constexpr std::size_t limb_span_powmod_scratch_size(std::size_t n, std::size_t en) noexcept
+{
+    using namespace _detail_limb_span_powmod;
+    constexpr bool Branchless = static_cast<bool>(Opt & branchless_option);
+    return table_size(window_size(en * limb_bits), Branchless) * n;
+}
+
+/**
+ * @brief Computes `b^e mod m` and stores it in @p d, where `m` is the modulus
+ * of @p ctx.
+ *
+ * By default, a sliding window is used whose size is chosen from the bit
+ * length of @p e. If ::branchless_option is set, a fixed window is used
+ * instead, and the sequence of operations and memory accesses only depends on
+ * the sizes of the operands, but not their values. The exponent is treated as
+ * an unsigned integer.
+ *
+ * @p d may overlap with @p b, but not with @p e or @p scratch.
+ *
+ * The behavior is undefined if @p b is not less than the modulus.
+ *
+ * @tparam Opt tests for ::branchless_option
+ * @param d destination of the power
+ * @param b base
+ * @param e exponent
+ * @param ctx Montgomery context of the modulus
+ * @param scratch scratch space of at least ::limb_span_powmod_scratch_size()
+ * limbs
+ */
+template<limb_span_option Opt = limb_span_option(0), std::size_t N, input_limb_span E, output_limb_span S>
+constexpr void limb_span_powmod(typename montgomery_context<N>::span_type d, typename montgomery_context<N>::const_span_type b, E e, const montgomery_context<N>& ctx, S scratch) noexcept
+{
+    assert(scratch.size() >= limb_span_powmod_scratch_size<Opt>(N, e.size()));
+    _detail_limb_span_powmod::powmod<Opt>(d, b, e, _detail_limb_span_powmod::montgomery_ops<N>{ ctx }, scratch);
+}
+
+/**
+ * @brief Computes `b^e mod m` and stores it in @p d, where `m` is the modulus
+ * of @p ctx.
+ *
+ * Same as the overload taking scratch space, except that the scratch space is
+ * taken from ::limb_span_scratch_arena().
+ */
+template<limb_span_option Opt = limb_span_option(0), std::size_t N, input_limb_span E>
+constexpr void limb_span_powmod(typename montgomery_context<N>::span_type d, typename montgomery_context<N>::const_span_type b, E e, const montgomery_context<N>& ctx)
+{
+    limb_span_scratch scratch(limb_span_powmod_scratch_size<Opt>(N, e.size()));
+    limb_span_powmod<Opt>(d, b, e, ctx, scratch.span());
+}
+
+/**
+ * @brief Computes `b^e mod m` and stores it in @p d, where `m` is the modulus
+ * of @p ctx.
+ *
+ * Same as the overload taking a ::montgomery_context, except that the modulus
+ * may be even. The products are reduced with ::barrett_context::reduce(), but
+ * computed by ::limb_span_mul(), whose running time depends on the values
+ * above the Karatsuba threshold even if ::branchless_option is set.
+ */
+template<limb_span_option Opt = limb_span_option(0), std::size_t N, input_limb_span E, output_limb_span S>
+constexpr void limb_span_powmod(typename barrett_context<N>::span_type d, typename barrett_context<N>::const_span_type b, E e, const barrett_context<N>& ctx, S scratch) noexcept
+{
+    assert(scratch.size() >= limb_span_powmod_scratch_size<Opt>(N, e.size()));
+    _detail_limb_span_powmod::powmod<Opt>(d, b, e, _detail_limb_span_powmod::barrett_ops<N>{ ctx }, scratch);
+}
+
+/**
+ * @brief Computes `b^e mod m` and stores it in @p d, where `m` is the modulus
+ * of @p ctx.
+ *
+ * Same as the overload taking scratch space, except that the scratch space is
+ * taken from ::limb_span_scratch_arena().
+ */
+template<limb_span_option Opt = limb_span_option(0), std::size_t N, input_limb_span E>
+constexpr void limb_span_powmod(typename barrett_context<N>::span_type d, typename barrett_context<N>::const_span_type b, E e, const barrett_context<N>& ctx)
+{
+    limb_span_scratch scratch(limb_span_powmod_scratch_size<Opt>(N, e.size()));
+    limb_span_powmod<Opt>(d, b, e, ctx, scratch.span());
+}
+
+}
+
+#endif // !GMATHS_INTEGERS_LIMB_SPAN_POWMOD_HPP_INCLUDED
@@ -0,0 +1,87 @@
+#ifndef GMATHS_INTEGERS_LIMB_SPAN_SCRATCH_HPP_INCLUDED
+#define GMATHS_INTEGERS_LIMB_SPAN_SCRATCH_HPP_INCLUDED
+
+/**
+ * @file gmaths/integers/limb_span/limb_span_scratch.hpp
+ * @brief Provides scratch space for the operations that allocate it
+ * internally.
+ *
+ * The scratch space is taken from an ::gmaths::utility::arena_resource per
+ * thread and given back in reverse order, so after the first few operations
+ * no memory is allocated anymore. The arena keeps the largest amount of
+ * scratch space a thread ever needed, which can be returned with
+ * `limb_span_scratch_arena().release()`.
+ */
+
+#include <gmaths/integers/limb_span/limb_span_base.hpp>
+#include <gmaths/utility/arena_resource.hpp>
+
+#include <type_traits>
+
+namespace gmaths::integers
+{
+
+/**
+ * @brief Returns the arena of the calling thread from which ::limb_span_scratch
+ * takes its memory.
+ */
+inline utility::arena_resource& limb_span_scratch_arena() noexcept
+{
+    thread_local utility::arena_resource arena;
+    return arena;
+}
+
+/**
+ * @brief Scratch space of a fixed number of limbs that is returned to the
+ * arena of the thread when it goes out of scope.
+ *
+ * Objects must be destroyed in reverse order of their construction, which is
+ * the case as long as they are local variables. During constant evaluation the
+ * memory is allocated with `new` instead.
+ */
+class limb_span_scratch
+{
+public:
+    /**
+     * @brief Takes @p n limbs from the arena of the calling thread.
+     *
+     * The limbs are not initialized.
+     */
+    constexpr explicit limb_span_scratch(std::size_t n)
+        : _size{ n }
+    {
+        if (std::is_constant_evaluated()) {
+            _data = new limb_type[n]();
+        } else {
+            utility::arena_resource& arena = limb_span_scratch_arena();
+            _marker = arena.mark();
+            _data = static_cast<limb_type*>(arena.allocate(n * sizeof(limb_type), alignof(limb_type)));
+        }
+    }
+
+    limb_span_scratch(const limb_span_scratch&) = delete;
+    limb_span_scratch& operator=(const limb_span_scratch&) = delete;
+
+    constexpr ~limb_span_scratch()
+    {
+        if (std::is_constant_evaluated()) {
+            delete[] _data;
+        } else {
+            limb_span_scratch_arena().rewind(_marker);
+        }
+    }
+
+    /**
+     * @brief Returns the limbs.
+     */
+    constexpr std::span<limb_type> span() const noexcept { return std::span<limb_type>(_data, _size); }
+
+private:
+    limb_type* _data = nullptr;
+    std::size_t _size;
+    utility::arena_resource::marker _marker{ };
+};
+
+}
+
+#endif // !GMATHS_INTEGERS_LIMB_SPAN_SCRATCH_HPP_INCLUDED
@@ -0,0 +1,162 @@
+#ifndef GMATHS_INTEGERS_LIMB_SPAN_SHIFT_HPP_INCLUDED
+#define GMATHS_INTEGERS_LIMB_SPAN_SHIFT_HPP_INCLUDED
+
+/**
+ * @file gmaths/integers/limb_span/limb_span_shift.hpp
+ * @brief Provides functions for shifting the values stored in limb_spans by an
+ * arbitrary number of bits.
+ *
+ * The source is extended infinitely like the operands of the bitwise
+ * operations, so a right shift is arithmetic if the source is marked as signed
+ * and logical otherwise. Every limb of the destination is computed from two
+ * limbs of the source by ::limb_shld() or ::limb_shrd(), so whole-limb and
+ * sub-limb parts of the shift are done in a single pass.
+ */
+
+#include <gmaths/integers/limb_span/limb_span_base.hpp>
+
+namespace gmaths::integers
+{
+
+namespace _detail_limb_span_shift
+{
+
+/*
+ * d[i] combines the limbs i - q and i - q - 1 of the extended source. The limbs
+ * are written from the most significant one down, so d may be s.
+ */
+template<bool Signed, output_limb_span D, input_limb_span S>
+constexpr void shl(D d, S s, std::size_t count) noexcept
+{
+    std::size_t n = d.size();
+    std::size_t sn = s.size();
+    std::size_t q = std::min(count / limb_bits, n);
+    int b = static_cast<int>(count % limb_bits);
+    limb_type ext = limb_span_sign_extension<Signed>(s);
+
+    std::size_t i = n;
+    if (n - q > sn + 1) {
+        i = q + sn + 1;
+        std::fill(d.begin() + i, d.end(), ext);
+    }
+    if (sn > 0) {
+        if (i > q + sn) {
+            d[i - 1] = limb_shld(ext, s[sn - 1], b);
+            --i;
+        }
+        for (; i > q + 1; --i) {
+            d[i - 1] = limb_shld(s[i - 1 - q], s[i - 2 - q], b);
+        }
+        if (i > q) {
+            d[i - 1] = s[0] << b;
+            --i;
+        }
+    }
+    std::fill(d.begin(), d.begin() + i, limb_type(0));
+}
+
+/*
+ * d[i] combines the limbs i + q and i + q + 1 of the extended source. The limbs
+ * are written from the least significant one up, so d may be s.
+ */
+template<bool Signed, output_limb_span D, input_limb_span S>
+constexpr void shr(D d, S s, std::size_t count) noexcept
+{
+    std::size_t n = d.size();
+    std::size_t sn = s.size();
+    std::size_t q = count / limb_bits;
+    int b = static_cast<int>(count % limb_bits);
+    limb_type ext = limb_span_sign_extension<Signed>(s);
+
+    std::size_t i = 0;
+    if (q < sn) {
+        std::size_t m = std::min(n, sn - q - 1);
+        for (; i < m; ++i) {
+            d[i] = limb_shrd(s[i + q + 1], s[i + q], b);
+        }
+        if (i < n) {
+            d[i] = limb_shrd(ext, s[sn - 1], b);
+            ++i;
+        }
+    }
+    std::fill(d.begin() + i, d.end(), ext);
+}
+
+}
+
+/**
+ * @brief Shifts @p d to the left by @p count bits.
+ *
+ * Bits shifted out of @p d are lost, zeroes are shifted in.
+ *
+ * @param d the span to be shifted
+ * @param count number of bits to shift by, may exceed the size of @p d
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D>
+constexpr void limb_span_shl_inplace(D d, std::size_t count) noexcept
+{
+    std::span<const limb_type, D::extent> s = d;
+    _detail_limb_span_shift::shl<false>(d, s, count);
+}
+
+/**
+ * @brief Stores @p s shifted to the left by @p count bits in @p d.
+ *
+ * @p s is extended to the size of @p d before the shift, by its sign bit if it
+ * is marked as signed and by zeroes otherwise. Bits shifted beyond the size of
+ * @p d are lost. @p d may be the same span as @p s.
+ *
+ * @tparam Opt tests for ::arg_signed_option, all other options are ignored
+ * @param d destination of the result
+ * @param s the span to be shifted
+ * @param count number of bits to shift by, may exceed the size of @p d
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span S>
+constexpr void limb_span_shl(D d, S s, std::size_t count) noexcept
+{
+    constexpr bool Signed = static_cast<bool>(Opt & arg_signed_option);
+    std::span<const limb_type, S::extent> s2 = s;
+    _detail_limb_span_shift::shl<Signed>(d, s2, count);
+}
+
+/**
+ * @brief Shifts @p d to the right by @p count bits.
+ *
+ * The shift is arithmetic if @p d is marked as signed, that is copies of the
+ * sign bit are shifted in, and logical otherwise.
+ *
+ * @tparam Opt tests for ::left_signed_option, all other options are ignored
+ * @param d the span to be shifted
+ * @param count number of bits to shift by, may exceed the size of @p d
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D>
+constexpr void limb_span_shr_inplace(D d, std::size_t count) noexcept
+{
+    constexpr bool Signed = static_cast<bool>(Opt & left_signed_option);
+    std::span<const limb_type, D::extent> s = d;
+    _detail_limb_span_shift::shr<Signed>(d, s, count);
+}
+
+/**
+ * @brief Stores @p s shifted to the right by @p count bits in @p d.
+ *
+ * The shift is arithmetic if @p s is marked as signed and logical otherwise.
+ * If @p d is larger than the shifted value, it is extended accordingly. @p d
+ * may be the same span as @p s.
+ *
+ * @tparam Opt tests for ::arg_signed_option, all other options are ignored
+ * @param d destination of the result
+ * @param s the span to be shifted
+ * @param count number of bits to shift by, may exceed the size of @p s
+ */
+template<limb_span_option Opt = limb_span_option(0), output_limb_span D, input_limb_span S>
+constexpr void limb_span_shr(D d, S s, std::size_t count) noexcept
+{
+    constexpr bool Signed = static_cast<bool>(Opt & arg_signed_option);
+    std::span<const limb_type, S::extent> s2 = s;
+    _detail_limb_span_shift::shr<Signed>(d, s2, count);
+}
+
+}
+
+#endif // !GMATHS_INTEGERS_LIMB_SPAN_SHIFT_HPP_INCLUDED
@@ -120,6 +120,60 @@ constexpr int limb_popcount(limb_type arg) noexcept
     return std::popcount(arg);
 }
 
+/**
+ * @brief Shifts the double limb `high:low` to the left and returns its high
+ * limb, that is @p high shifted left with the top bits of @p low shifted in.
+ *
+ * Compiles to the `shld` instruction on x86.
+ *
+ * @param high the high limb.
+ * @param low the low limb.
+ * @param s number of bits to shift by, must be less than ::limb_bits.
+ * @return the high limb of the shifted value.
+ */
+constexpr limb_type limb_shld(limb_type high, limb_type low, int s) noexcept
+{
+#if !defined(GMATHS_NO_INTRINSICS) && defined(__GNUC__) && defined(__SIZEOF_INT128__)
+    unsigned __int128 tmp = static_cast<unsigned __int128>(high) << limb_bits | low;
+    return static_cast<limb_type>(tmp << (static_cast<unsigned>(s) % limb_bits) >> limb_bits);
+#else
+#if !defined(GMATHS_NO_INTRINSICS) && defined(_MSC_VER) && defined(_M_X64)
+    if (!std::is_constant_evaluated()) {
+        return __shiftleft128(low, high, static_cast<unsigned char>(s));
+    }
+#endif
+    // shifting low in two steps avoids the undefined shift by limb_bits for s == 0
+    return high << s | (low >> 1) >> (limb_bits - 1 - s);
+#endif
+}
+
+/**
+ * @brief Shifts the double limb `high:low` to the right and returns its low
+ * limb, that is @p low shifted right with the bottom bits of @p high shifted
+ * in.
+ *
+ * Compiles to the `shrd` instruction on x86.
+ *
+ * @param high the high limb.
+ * @param low the low limb.
+ * @param s number of bits to shift by, must be less than ::limb_bits.
+ * @return the low limb of the shifted value.
+ */
+constexpr limb_type limb_shrd(limb_type high, limb_type low, int s) noexcept
+{
+#if !defined(GMATHS_NO_INTRINSICS) && defined(__GNUC__) && defined(__SIZEOF_INT128__)
+    unsigned __int128 tmp = static_cast<unsigned __int128>(high) << limb_bits | low;
+    return static_cast<limb_type>(tmp >> (static_cast<unsigned>(s) % limb_bits));
+#else
+#if !defined(GMATHS_NO_INTRINSICS) && defined(_MSC_VER) && defined(_M_X64)
+    if (!std::is_constant_evaluated()) {
+        return __shiftright128(low, high, static_cast<unsigned char>(s));
+    }
+#endif
+    return low >> s | (high << 1) << (limb_bits - 1 - s);
+#endif
+}
+
 /**@{*/
 /**
  * @brief Increments the argument by one or by the provided carry bit, stores
@@ -686,6 +740,146 @@ constexpr limb_type limb_div(limb_type l_high, limb_type l_low, limb_type r, lim
 #endif
 }
 
+/**
+ * @brief Computes the reciprocal `floor((2^128 - 1) / r) - 2^64` of a
+ * normalized divisor for use with ::limb_div_preinv().
+ *
+ * The behavior is undefined if the highest bit of @p r is not set.
+ *
+ * @param r normalized divisor.
+ * @return the reciprocal of the divisor.
+ */
+constexpr limb_type limb_reciprocal(limb_type r) noexcept
+{
+    assert(r >> (limb_bits - 1));
+    limb_type rem = 0;
+    return limb_div(~r, ~limb_type(0), r, &rem);
+}
+
+/**
+ * @brief Computes the reciprocal `floor((2^192 - 1) / r) - 2^64` of a
+ * normalized two limbs wide divisor for use with ::limb_div_preinv().
+ *
+ * The behavior is undefined if the highest bit of @p r_high is not set.
+ *
+ * @param r_high high part of the divisor.
+ * @param r_low low part of the divisor.
+ * @return the reciprocal of the divisor.
+ */
+constexpr limb_type limb_reciprocal(limb_type r_high, limb_type r_low) noexcept
+{
+    limb_type v = limb_reciprocal(r_high);
+
+    // adjust the reciprocal of r_high by the contribution of r_low
+    limb_type p = r_high * v + r_low;
+    if (p < r_low) {
+        --v;
+        if (p >= r_high) {
+            --v;
+            p -= r_high;
+        }
+        p -= r_high;
+    }
+    limb_type t1 = 0;
+    limb_type t0 = limb_mul(r_low, v, &t1);
+    p += t1;
+    if (p < t1) {
+        --v;
+        if (p > r_high || (p == r_high && t0 >= r_low)) {
+            --v;
+        }
+    }
+    return v;
+}
+
+/**@{*/
+/**
+ * @brief Divides by a normalized divisor with a precomputed reciprocal,
+ * stores the remainder at the provided address(es) and returns the quotient.
+ *
+ * This is the algorithm by Möller and Granlund, "Improved division by
+ * invariant integers", which replaces the division instruction by two
+ * multiplications and is therefore considerably faster than ::limb_div() when
+ * dividing by the same divisor repeatedly.
+ *
+ * The two limbs by one limb division requires `l_high < r` and the reciprocal
+ * `v == limb_reciprocal(r)`. The three limbs by two limbs division requires
+ * `l_high:l_mid < r_high:r_low` and `v == limb_reciprocal(r_high, r_low)`. In
+ * both cases the highest bit of the divisor must be set and the behavior is
+ * undefined otherwise or if the remainder pointers are not valid.
+ *
+ * @param l_high high part of the dividend.
+ * @param l_mid middle part of the dividend.
+ * @param l_low low part of the dividend.
+ * @param r (high part of the) divisor.
+ * @param r_low low part of the divisor.
+ * @param v reciprocal of the divisor.
+ * @param remainder address where the (high part of the) remainder will be
+ * stored.
+ * @param remainder_low address where the low part of the remainder will be
+ * stored.
+ * @return the quotient of the division.
+ */
+constexpr limb_type limb_div_preinv(limb_type l_high, limb_type l_low, limb_type r, limb_type v, limb_type* remainder) noexcept
+{
+    assert(l_high < r);
+    assert(r >> (limb_bits - 1));
+
+    limb_type q1 = 0;
+    limb_type q0 = limb_mul(v, l_high, &q1);
+    q1 += l_high + limb_add(q0, l_low, &q0);
+    ++q1;
+
+    limb_type rem = l_low - q1 * r;
+    // the conditions are unpredictable for random operands, so prefer masks
+    limb_type mask = limb_type(0) - (rem > q0);
+    q1 += mask;
+    rem += mask & r;
+    if (rem >= r) {
+        // unlikely
+        ++q1;
+        rem -= r;
+    }
+    *remainder = rem;
+    return q1;
+}
+
+constexpr limb_type limb_div_preinv(limb_type l_high, limb_type l_mid, limb_type l_low, limb_type r_high, limb_type r_low, limb_type v, limb_type* remainder, limb_type* remainder_low) noexcept
+{
+    assert(l_high < r_high || (l_high == r_high && l_mid < r_low));
+    assert(r_high >> (limb_bits - 1));
+
+    limb_type q1 = 0;
+    limb_type q0 = limb_mul(v, l_high, &q1);
+    q1 += l_high + limb_add(q0, l_mid, &q0);
+
+    // r = l_mid:l_low - (q1 * r_high + r_high:r_low) - q1 * r_low
+    limb_type r1 = l_mid - q1 * r_high;
+    limb_type r0 = 0;
+    bool borrow = limb_sub(l_low, r_low, &r0);
+    r1 -= r_high + borrow;
+    limb_type t1 = 0;
+    limb_type t0 = limb_mul(r_low, q1, &t1);
+    borrow = limb_sub(r0, t0, &r0);
+    r1 -= t1 + borrow;
+    ++q1;
+
+    limb_type mask = limb_type(0) - (r1 >= q0);
+    q1 += mask;
+    bool carry = limb_add(r0, mask & r_low, &r0);
+    r1 += (mask & r_high) + carry;
+    if (r1 > r_high || (r1 == r_high && r0 >= r_low)) {
+        // unlikely
+        ++q1;
+        borrow = limb_sub(r0, r_low, &r0);
+        r1 -= r_high + borrow;
+    }
+    *remainder = r1;
+    *remainder_low = r0;
+    return q1;
+}
+/**@}*/
+
 }
 
 #endif
@@ -0,0 +1,159 @@
+#ifndef GMATHS_UTILITY_ARENA_RESOURCE_HPP_INCLUDED
+#define GMATHS_UTILITY_ARENA_RESOURCE_HPP_INCLUDED
+
+/**
+ * @file gmaths/utility/arena_resource.hpp
+ * @brief Provides a bump pointer memory resource that is reset as a whole.
+ *
+ * Computations that create many short lived temporaries, for example all big
+ * integers of one request, can allocate them from an ::arena_resource and
+ * discard all of them at once with ::arena_resource::reset() instead of
+ * freeing them one at a time.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace gmaths::utility
+{
+
+/**
+ * @brief Memory resource that hands out memory by advancing a pointer through
+ * large chunks.
+ *
+ * Deallocation does nothing, the memory is reclaimed by ::reset(), which makes
+ * all chunks available again without returning them to the upstream resource,
+ * or by ::release(), which does. ::mark() and ::rewind() reclaim only the
+ * memory allocated after a certain point, which allows using the arena like a
+ * stack.
+ *
+ * The resource is not thread safe.
+ */
+class arena_resource : public std::pmr::memory_resource
+{
+public:
+    /**
+     * @brief Default size of the first chunk in bytes.
+     */
+    static constexpr std::size_t default_chunk_size = 4096;
+
+    /**
+     * @brief Position in the arena returned by ::mark().
+     */
+    struct marker
+    {
+        std::size_t chunk = 0;
+        std::size_t offset = 0;
+    };
+
+    /**
+     * @brief Initializes an empty arena.
+     *
+     * No memory is allocated until the first allocation. Each new chunk is
+     * twice as large as the previous one.
+     *
+     * @param chunk_size size of the first chunk in bytes
+     * @param upstream resource the chunks are allocated from
+     */
+    explicit arena_resource(std::size_t chunk_size = default_chunk_size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+        : _upstream{ upstream }, _initial_size{ std::max<std::size_t>(chunk_size, 1) }, _next_size{ _initial_size }
+    {
+    }
+
+    arena_resource(const arena_resource&) = delete;
+    arena_resource& operator=(const arena_resource&) = delete;
+
+    ~arena_resource()
+    {
+        release();
+    }
+
+    /**
+     * @brief Returns the resource the chunks are allocated from.
+     */
+    std::pmr::memory_resource* upstream_resource() const noexcept { return _upstream; }
+
+    /**
+     * @brief Returns the current position in the arena.
+     */
+    marker mark() const noexcept { return marker{ _current, _offset }; }
+
+    /**
+     * @brief Reclaims all memory allocated since @p m was returned by ::mark().
+     *
+     * The behavior is undefined if the arena was rewound to an earlier
+     * position or released in the meantime.
+     */
+    void rewind(marker m) noexcept
+    {
+        _current = m.chunk;
+        _offset = m.offset;
+    }
+
+    /**
+     * @brief Reclaims all memory allocated from the arena, but keeps the chunks
+     * for subsequent allocations.
+     */
+    void reset() noexcept { rewind(marker{ }); }
+
+    /**
+     * @brief Returns all chunks to the upstream resource.
+     */
+    void release() noexcept
+    {
+        for (const chunk& c : _chunks) {
+            _upstream->deallocate(c.data, c.size, alignof(std::max_align_t));
+        }
+        _chunks.clear();
+        _next_size = _initial_size;
+        reset();
+    }
+
+private:
+    struct chunk
+    {
+        std::byte* data;
+        std::size_t size;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        for (;;) {
+            if (_current < _chunks.size()) {
+                const chunk& c = _chunks[_current];
+                std::size_t begin = (reinterpret_cast<std::uintptr_t>(c.data) + _offset + alignment - 1) / alignment * alignment - reinterpret_cast<std::uintptr_t>(c.data);
+                if (begin <= c.size && bytes <= c.size - begin) {
+                    _offset = begin + bytes;
+                    return c.data + begin;
+                }
+                // the rest of a retained chunk is skipped
+                ++_current;
+                _offset = 0;
+                continue;
+            }
+
+            std::size_t size = std::max(_next_size, bytes + alignment);
+            _chunks.reserve(_chunks.size() + 1);
+            _chunks.push_back(chunk{ static_cast<std::byte*>(_upstream->allocate(size, alignof(std::max_align_t))), size });
+            _next_size = 2 * size;
+        }
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) noexcept override { }
+
+    bool do_is_equal(const std::pmr::memory_resource& o) const noexcept override { return this == &o; }
+
+    std::pmr::memory_resource* _upstream;
+    std::size_t _initial_size;
+    std::size_t _next_size;
+    std::vector<chunk> _chunks;
+    std::size_t _current = 0;
+    std::size_t _offset = 0;
+};
+
+}
+
+#endif // !GMATHS_UTILITY_ARENA_RESOURCE_HPP_INCLUDED
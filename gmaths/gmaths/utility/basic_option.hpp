@@ -71,11 +71,11 @@ struct basic_option
      */
     constexpr basic_option operator~() const noexcept { return basic_option(~_value); }
     constexpr basic_option& operator&=(basic_option o) noexcept { _value &= o._value; return *this; }
-    constexpr basic_option operator&(basic_option o) const noexcept { return r &= *this; }
+    constexpr basic_option operator&(basic_option o) const noexcept { return o &= *this; }
     constexpr basic_option& operator|=(basic_option o) noexcept { _value |= o._value; return *this; }
-    constexpr basic_option operator|(basic_option o) const noexcept { return r |= *this; }
+    constexpr basic_option operator|(basic_option o) const noexcept { return o |= *this; }
     constexpr basic_option& operator^=(basic_option o) noexcept { _value ^= o._value; return *this; }
-    constexpr basic_option operator^(basic_option o) const noexcept { return r ^= *this; }
+    constexpr basic_option operator^(basic_option o) const noexcept { return o ^= *this; }
     /**@}*/
 
     /**
@@ -0,0 +1,199 @@
+#ifndef GMATHS_UTILITY_CPU_FEATURES_HPP_INCLUDED
+#define GMATHS_UTILITY_CPU_FEATURES_HPP_INCLUDED
+
+/**
+ * @file gmaths/utility/cpu_features.hpp
+ * @brief Detection of optional instruction set extensions at runtime.
+ *
+ * Kernels that make use of instructions beyond the baseline of the target
+ * platform query the features listed here once and select an implementation
+ * accordingly. If `GMATHS_NO_INTRINSICS` is defined or the platform is not
+ * supported, all features are reported as unavailable.
+ */
+
+#ifndef GMATHS_NO_INTRINSICS
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#endif
+#endif
+
+namespace gmaths::utility
+{
+
+/**
+ * @brief Set of instruction set extensions that are relevant to the gmaths
+ * library.
+ */
+struct cpu_features
+{
+    /**
+     * @brief Streaming SIMD extensions 2, 128 bit integer operations.
+     */
+    bool sse2 = false;
+
+    /**
+     * @brief Population count instruction (`popcnt`).
+     */
+    bool popcnt = false;
+
+    /**
+     * @brief Bit manipulation instructions 2 (`mulx`, `shlx`, `shrx`, ...).
+     */
+    bool bmi2 = false;
+
+    /**
+     * @brief Multi-precision add-carry instructions (`adcx`, `adox`).
+     */
+    bool adx = false;
+
+    /**
+     * @brief Advanced vector extensions 2, 256 bit integer operations.
+     */
+    bool avx2 = false;
+
+    /**
+     * @brief AVX-512 foundation, 512 bit integer operations including
+     * `vpternlog`.
+     */
+    bool avx512f = false;
+
+    /**
+     * @brief Tests if all features of @p required are present.
+     */
+    constexpr bool includes(const cpu_features& required) const noexcept
+    {
+        return (sse2 || !required.sse2) && (popcnt || !required.popcnt) && (bmi2 || !required.bmi2)
+            && (adx || !required.adx) && (avx2 || !required.avx2) && (avx512f || !required.avx512f);
+    }
+
+    /**
+     * @brief Returns the features present in both sets.
+     */
+    friend constexpr cpu_features operator&(const cpu_features& l, const cpu_features& r) noexcept
+    {
+        return cpu_features{ l.sse2 && r.sse2, l.popcnt && r.popcnt, l.bmi2 && r.bmi2, l.adx && r.adx, l.avx2 && r.avx2, l.avx512f && r.avx512f };
+    }
+
+    friend constexpr bool operator==(const cpu_features&, const cpu_features&) noexcept = default;
+};
+
+/**
+ * @def GMATHS_TARGET_POPCNT
+ * @brief Enables the population count instruction for a single function.
+ */
+
+/**
+ * @def GMATHS_TARGET_AVX2
+ * @brief Enables AVX2 code generation for a single function.
+ *
+ * GCC and Clang only emit instructions beyond the baseline of the target
+ * platform in functions marked accordingly. Such functions must only be called
+ * after checking ::gmaths::utility::cpu_features::avx2.
+ */
+
+/**
+ * @def GMATHS_TARGET_AVX512
+ * @brief Enables AVX-512 foundation code generation for a single function.
+ */
+#if defined(__GNUC__)
+#define GMATHS_TARGET_POPCNT __attribute__((target("popcnt")))
+#define GMATHS_TARGET_AVX2 __attribute__((target("avx2")))
+#define GMATHS_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define GMATHS_TARGET_POPCNT
+#define GMATHS_TARGET_AVX2
+#define GMATHS_TARGET_AVX512
+#endif
+
+namespace _detail_cpu_features
+{
+
+/*
+ * Executes cpuid for the given leaf and subleaf and stores eax, ebx, ecx, edx
+ * in this order. Returns false if the leaf is not supported.
+ */
+inline bool cpuid(unsigned leaf, unsigned subleaf, unsigned* regs) noexcept
+{
+#if !defined(GMATHS_NO_INTRINSICS) && defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    int info[4]{ };
+    __cpuid(info, 0);
+    if (static_cast<unsigned>(info[0]) < leaf) {
+        return false;
+    }
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = static_cast<unsigned>(info[i]);
+    }
+    return true;
+#elif !defined(GMATHS_NO_INTRINSICS) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3]) != 0;
+#else
+    static_cast<void>(leaf);
+    static_cast<void>(subleaf);
+    static_cast<void>(regs);
+    return false;
+#endif
+}
+
+/*
+ * Returns the register state enabled by the operating system. Vector
+ * extensions are only usable if their registers are saved on context
+ * switches.
+ */
+inline unsigned long long xgetbv() noexcept
+{
+#if !defined(GMATHS_NO_INTRINSICS) && defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    return _xgetbv(0);
+#elif !defined(GMATHS_NO_INTRINSICS) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    unsigned eax = 0;
+    unsigned edx = 0;
+    __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#else
+    return 0;
+#endif
+}
+
+inline cpu_features detect() noexcept
+{
+    cpu_features result{ };
+    unsigned regs[4]{ };
+    unsigned long long xcr0 = 0;
+    if (cpuid(1, 0, regs)) {
+        result.sse2 = (regs[3] >> 26) & 1;
+        result.popcnt = (regs[2] >> 23) & 1;
+        if ((regs[2] >> 27) & 1) {
+            xcr0 = xgetbv();
+        }
+    }
+    // xmm and ymm state, additionally opmask and zmm state for AVX-512
+    bool avx_state = (xcr0 & 0x6) == 0x6;
+    bool avx512_state = (xcr0 & 0xe6) == 0xe6;
+    if (cpuid(7, 0, regs)) {
+        result.bmi2 = (regs[1] >> 8) & 1;
+        result.adx = (regs[1] >> 19) & 1;
+        result.avx2 = avx_state && ((regs[1] >> 5) & 1);
+        result.avx512f = avx512_state && ((regs[1] >> 16) & 1);
+    }
+    return result;
+}
+
+}
+
+/**
+ * @brief Returns the features of the executing CPU.
+ *
+ * The detection runs once on the first call, every subsequent call returns
+ * the cached result.
+ */
+inline const cpu_features& detected_cpu_features() noexcept
+{
+    static const cpu_features features = _detail_cpu_features::detect();
+    return features;
+}
+
+}
+
+#endif // !GMATHS_UTILITY_CPU_FEATURES_HPP_INCLUDED
@@ -0,0 +1,53 @@
+#ifndef GMATHS_UTILITY_EXECUTION_HPP_INCLUDED
+#define GMATHS_UTILITY_EXECUTION_HPP_INCLUDED
+
+/**
+ * @file gmaths/utility/execution.hpp
+ * @brief Provides the execution policy that selects the parallel overloads of
+ * operations, similar to `std::execution::par`.
+ */
+
+#include <gmaths/utility/thread_pool.hpp>
+
+namespace gmaths::utility
+{
+
+/**
+ * @brief Requests that an operation is split into parts that run on the
+ * threads of a ::thread_pool.
+ *
+ * Operations on operands too small to benefit from threads run sequentially.
+ */
+class parallel_policy
+{
+public:
+    /**
+     * @brief Runs the operations on ::default_thread_pool().
+     */
+    constexpr parallel_policy() noexcept = default;
+
+    /**
+     * @brief Runs the operations on @p pool, which must outlive them.
+     */
+    constexpr explicit parallel_policy(thread_pool& pool) noexcept : _pool{ &pool } { }
+
+    /**
+     * @brief Returns the pool the operations run on.
+     */
+    thread_pool& pool() const
+    {
+        return _pool ? *_pool : default_thread_pool();
+    }
+
+private:
+    thread_pool* _pool = nullptr;
+};
+
+/**
+ * @brief Policy object that runs operations on ::default_thread_pool().
+ */
+inline constexpr parallel_policy par{ };
+
+}
+
+#endif // !GMATHS_UTILITY_EXECUTION_HPP_INCLUDED
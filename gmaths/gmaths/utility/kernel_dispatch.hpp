@@ -0,0 +1,229 @@
+#ifndef GMATHS_UTILITY_KERNEL_DISPATCH_HPP_INCLUDED
+#define GMATHS_UTILITY_KERNEL_DISPATCH_HPP_INCLUDED
+
+/**
+ * @file gmaths/utility/kernel_dispatch.hpp
+ * @brief Central selection of kernel implementations by CPU features.
+ *
+ * Kernels that exist in several variants for different instruction set
+ * extensions describe each variant by a ::kernel_variant and let
+ * ::select_kernel() pick the first one the CPU supports. The selection is
+ * based on ::effective_cpu_features(), which can be restricted to a lower
+ * level with the environment variable `GMATHS_CPU_LEVEL` for benchmarking
+ * and testing, so that one binary covers every level. The levels follow the
+ * x86-64 microarchitecture levels, restricted to the features gmaths uses:
+ *
+ * | value       | features                                  |
+ * |-------------|-------------------------------------------|
+ * | `portable`  | none, only portable C++                   |
+ * | `x86-64`    | SSE2                                      |
+ * | `x86-64-v2` | additionally `popcnt`                     |
+ * | `x86-64-v3` | additionally AVX2 and BMI2                |
+ * | `x86-64-v4` | additionally AVX-512 foundation           |
+ * | `native`    | everything the CPU supports (the default) |
+ *
+ * ADX is not part of any level, so the kernels that require it are only
+ * selected with `native`. An empty variable means `native`, any other value
+ * that is not listed means `portable`, so that a misspelt level does not go
+ * unnoticed in ::active_kernels().
+ *
+ * Every selection is recorded and can be listed with ::active_kernels().
+ */
+
+#include <gmaths/utility/cpu_features.hpp>
+
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace gmaths::utility
+{
+
+/**
+ * @brief Implementation of a kernel together with the features it requires.
+ *
+ * @tparam Fn function pointer type of the kernel
+ */
+template<typename Fn>
+struct kernel_variant
+{
+    /**
+     * @brief Name of the variant, usually the instruction set it makes use of.
+     */
+    std::string_view name;
+
+    /**
+     * @brief Features that must be present to use the variant.
+     */
+    cpu_features requires_features;
+
+    /**
+     * @brief The implementation.
+     */
+    Fn function;
+};
+
+/**
+ * @brief Variant selected for a kernel.
+ */
+struct kernel_selection
+{
+    std::string kernel;
+    std::string variant;
+};
+
+namespace _detail_kernel_dispatch
+{
+
+/*
+ * Reads an environment variable without the deprecation warnings of MSVC.
+ */
+inline std::string environment(const char* name)
+{
+#ifdef _MSC_VER
+    char* value = nullptr;
+    std::size_t size = 0;
+    if (_dupenv_s(&value, &size, name) != 0 || value == nullptr) {
+        return std::string();
+    }
+    std::string result(value);
+    std::free(value);
+    return result;
+#else
+    const char* value = std::getenv(name);
+    return value ? std::string(value) : std::string();
+#endif
+}
+
+/*
+ * Returns the features allowed by the given level, or no features if the
+ * level is unknown.
+ */
+inline cpu_features level_features(std::string_view level) noexcept
+{
+    if (level.empty() || level == "native") {
+        return cpu_features{ true, true, true, true, true, true };
+    }
+    cpu_features f{ };
+    if (level == "portable") {
+        return f;
+    }
+    f.sse2 = true;
+    if (level == "x86-64") {
+        return f;
+    }
+    f.popcnt = true;
+    if (level == "x86-64-v2") {
+        return f;
+    }
+    f.avx2 = true;
+    f.bmi2 = true;
+    if (level == "x86-64-v3") {
+        return f;
+    }
+    f.avx512f = true;
+    if (level == "x86-64-v4") {
+        return f;
+    }
+    return cpu_features{ };
+}
+
+inline cpu_features effective() noexcept
+{
+    try {
+        return detected_cpu_features() & level_features(environment("GMATHS_CPU_LEVEL"));
+    } catch (...) {
+        return detected_cpu_features();
+    }
+}
+
+struct registry
+{
+    std::mutex mutex;
+    std::vector<kernel_selection> selections;
+};
+
+inline registry& global_registry() noexcept
+{
+    static registry r;
+    return r;
+}
+
+inline void record(std::string_view kernel, std::string_view instance, std::string_view variant) noexcept
+{
+    registry& r = global_registry();
+    try {
+        std::string name(kernel);
+        if (!instance.empty()) {
+            name.append("<").append(instance).append(">");
+        }
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.selections.push_back(kernel_selection{ std::move(name), std::string(variant) });
+    } catch (...) {
+        // the report is merely informative
+    }
+}
+
+}
+
+/**
+ * @brief Returns the features of the executing CPU that kernels may use.
+ *
+ * Same as ::detected_cpu_features(), restricted to the level given by the
+ * environment variable `GMATHS_CPU_LEVEL` if it is set. The variable is read
+ * once on the first call.
+ */
+inline const cpu_features& effective_cpu_features() noexcept
+{
+    static const cpu_features features = _detail_kernel_dispatch::effective();
+    return features;
+}
+
+/**
+ * @brief Selects the first variant whose required features are available
+ * and records the selection.
+ *
+ * The last variant should not require any features, it is selected if no
+ * other variant is supported. Callers cache the result, so that each kernel
+ * is selected once.
+ *
+ * @param kernel name of the kernel for ::active_kernels()
+ * @param instance name of the instantiation of a kernel template, may be
+ * empty
+ * @param variants variants ordered from best to worst
+ * @return the function of the selected variant
+ */
+template<typename Fn, std::size_t N>
+Fn select_kernel(std::string_view kernel, std::string_view instance, const kernel_variant<Fn> (&variants)[N]) noexcept
+{
+    static_assert(N > 0, "select_kernel requires at least one variant");
+    const cpu_features& features = effective_cpu_features();
+    for (const kernel_variant<Fn>& v : variants) {
+        if (features.includes(v.requires_features)) {
+            _detail_kernel_dispatch::record(kernel, instance, v.name);
+            return v.function;
+        }
+    }
+    _detail_kernel_dispatch::record(kernel, instance, variants[N - 1].name);
+    return variants[N - 1].function;
+}
+
+/**
+ * @brief Returns the kernels selected so far together with their variants.
+ *
+ * Kernels are selected on their first use, kernels that were not used yet are
+ * not listed.
+ */
+inline std::vector<kernel_selection> active_kernels()
+{
+    _detail_kernel_dispatch::registry& r = _detail_kernel_dispatch::global_registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.selections;
+}
+
+}
+
+#endif // !GMATHS_UTILITY_KERNEL_DISPATCH_HPP_INCLUDED
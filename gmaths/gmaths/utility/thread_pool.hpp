@@ -0,0 +1,263 @@
+#ifndef GMATHS_UTILITY_THREAD_POOL_HPP_INCLUDED
+#define GMATHS_UTILITY_THREAD_POOL_HPP_INCLUDED
+
+/**
+ * @file gmaths/utility/thread_pool.hpp
+ * @brief Provides a work-stealing thread pool for data parallel loops.
+ *
+ * Every worker owns a queue of tasks. Workers take tasks from the back of
+ * their own queue and steal from the front of the queues of other workers
+ * once their own queue runs empty, so that uneven tasks do not leave workers
+ * idle while others are still busy.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace gmaths::utility
+{
+
+namespace _detail_thread_pool
+{
+
+/*
+ * A loop handed to the pool. The tasks of a job are its indices, pending
+ * counts the tasks that did not finish yet.
+ */
+struct job
+{
+    void (*run)(const void*, std::size_t) noexcept;
+    const void* body;
+    std::atomic<std::size_t> pending;
+};
+
+struct task
+{
+    job* owner;
+    std::size_t index;
+};
+
+struct task_queue
+{
+    std::mutex mutex;
+    std::deque<task> tasks;
+};
+
+}
+
+/**
+ * @brief Pool of worker threads that execute the iterations of parallel loops.
+ *
+ * The thread that starts a loop with ::parallel_for() executes tasks as well
+ * until the loop is finished, so a pool without workers runs the loop
+ * sequentially and loops may be nested.
+ */
+class thread_pool
+{
+public:
+    /**
+     * @brief Starts the worker threads.
+     *
+     * @param workers number of threads in addition to the threads that start
+     * loops
+     */
+    explicit thread_pool(std::size_t workers)
+        : _queues(std::max<std::size_t>(workers, 1))
+    {
+        for (auto& q : _queues) {
+            q = std::make_unique<_detail_thread_pool::task_queue>();
+        }
+        try {
+            for (std::size_t i = 0; i < workers; ++i) {
+                _threads.emplace_back([this, i] { work(i); });
+            }
+        } catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    /**
+     * @brief Waits for the workers to finish the queued tasks and joins them.
+     */
+    ~thread_pool()
+    {
+        stop();
+    }
+
+    /**
+     * @brief Returns the number of threads that execute a loop, including the
+     * thread that starts it.
+     */
+    std::size_t concurrency() const noexcept { return _threads.size() + 1; }
+
+    /**
+     * @brief Calls @p body for every index in `[0, count)` and returns when
+     * all calls have returned.
+     *
+     * The calls are distributed over the workers and the calling thread in no
+     * particular order. @p body must not throw.
+     *
+     * @param count number of iterations
+     * @param body function object that is called with the index of each
+     * iteration
+     */
+    template<typename Body>
+    void parallel_for(std::size_t count, const Body& body)
+    {
+        static_assert(std::is_nothrow_invocable_v<const Body&, std::size_t>, "the body of a parallel loop must not throw");
+
+        if (count == 0) {
+            return;
+        }
+        if (count == 1 || _threads.empty()) {
+            for (std::size_t i = 0; i < count; ++i) {
+                body(i);
+            }
+            return;
+        }
+
+        _detail_thread_pool::job j{ &invoke<Body>, &body, count };
+        std::size_t first = _next_queue.fetch_add(1, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < count; ++i) {
+            push((first + i) % _queues.size(), _detail_thread_pool::task{ &j, i });
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+        }
+        _wake.notify_all();
+
+        _detail_thread_pool::task t{ };
+        while (j.pending.load(std::memory_order_acquire) != 0) {
+            if (steal(first, t)) {
+                execute(t);
+            } else {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _done.wait(lock, [&] { return j.pending.load(std::memory_order_acquire) == 0 || _queued.load() != 0; });
+            }
+        }
+    }
+
+private:
+    template<typename Body>
+    static void invoke(const void* body, std::size_t index) noexcept
+    {
+        (*static_cast<const Body*>(body))(index);
+    }
+
+    void push(std::size_t queue, _detail_thread_pool::task t)
+    {
+        _detail_thread_pool::task_queue& q = *_queues[queue];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.push_back(t);
+        _queued.fetch_add(1);
+    }
+
+    bool pop(std::size_t queue, _detail_thread_pool::task& t) noexcept
+    {
+        _detail_thread_pool::task_queue& q = *_queues[queue];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) {
+            return false;
+        }
+        t = q.tasks.back();
+        q.tasks.pop_back();
+        _queued.fetch_sub(1);
+        return true;
+    }
+
+    /*
+     * Takes the oldest task of the first non-empty queue, starting with the
+     * given one.
+     */
+    bool steal(std::size_t first, _detail_thread_pool::task& t) noexcept
+    {
+        for (std::size_t k = 0; k < _queues.size(); ++k) {
+            _detail_thread_pool::task_queue& q = *_queues[(first + k) % _queues.size()];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.tasks.empty()) {
+                t = q.tasks.front();
+                q.tasks.pop_front();
+                _queued.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void execute(_detail_thread_pool::task t) noexcept
+    {
+        t.owner->run(t.owner->body, t.index);
+        if (t.owner->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // the owner may return as soon as it sees 0, so the job must not be touched anymore
+            std::lock_guard<std::mutex> lock(_mutex);
+            _done.notify_all();
+        }
+    }
+
+    void work(std::size_t self) noexcept
+    {
+        _detail_thread_pool::task t{ };
+        for (;;) {
+            if (pop(self, t) || steal(self + 1, t)) {
+                execute(t);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [&] { return _stopping || _queued.load() != 0; });
+            if (_stopping && _queued.load() == 0) {
+                return;
+            }
+        }
+    }
+
+    void stop() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_all();
+        for (std::thread& t : _threads) {
+            t.join();
+        }
+        _threads.clear();
+    }
+
+    std::vector<std::unique_ptr<_detail_thread_pool::task_queue>> _queues;
+    std::vector<std::thread> _threads;
+    std::atomic<std::size_t> _queued{ 0 };
+    std::atomic<std::size_t> _next_queue{ 0 };
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    bool _stopping = false;
+};
+
+/**
+ * @brief Returns the pool shared by all parallel operations that do not
+ * specify a pool.
+ *
+ * The pool is created on the first call with one worker less than the
+ * hardware threads, since the calling thread takes part in every loop.
+ */
+inline thread_pool& default_thread_pool()
+{
+    static thread_pool pool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+    return pool;
+}
+
+}
+
+#endif // !GMATHS_UTILITY_THREAD_POOL_HPP_INCLUDED